@@ -0,0 +1,164 @@
+/* arena.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Arena implementation.
+*/
+
+#include "reflect.h"
+
+namespace reflect {
+
+namespace {
+
+size_t blockSize(size_t size)
+{
+    return (size + Arena::Alignment - 1) & ~size_t(Arena::Alignment - 1);
+}
+
+size_t hashArguments(const Argument* args, size_t size)
+{
+    size_t hash = size;
+    for (size_t i = 0; i < size; ++i) {
+        size_t arg = uintptr_t(args[i].type());
+        arg ^= size_t(args[i].refType()) << 1 | size_t(args[i].isConst());
+        hash = (hash ^ arg) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // namespace anonymous
+
+
+/******************************************************************************/
+/* ARENA                                                                      */
+/******************************************************************************/
+
+Arena::
+Arena() : pos(nullptr), end(nullptr), memory_(0), used_(0)
+{
+    std::fill(std::begin(freeLists), std::end(freeLists), nullptr);
+}
+
+Arena::
+~Arena()
+{
+    for (void* chunk : chunks) std::free(chunk);
+}
+
+void*
+Arena::
+bump(size_t size)
+{
+    if (size_t(end - pos) < size) {
+        void* chunk = std::malloc(ChunkSize);
+        if (!chunk) reflectError("unable to allocate arena chunk");
+
+        chunks.push_back(chunk);
+        memory_ += ChunkSize;
+
+        pos = static_cast<uint8_t*>(chunk);
+        end = pos + ChunkSize;
+    }
+
+    void* ptr = pos;
+    pos += size;
+    return ptr;
+}
+
+void*
+Arena::
+alloc(size_t size)
+{
+    size = blockSize(std::max<size_t>(size, 1));
+
+    std::lock_guard<std::mutex> guard(lock);
+    used_ += size;
+
+    if (size > MaxBlock) {
+        memory_ += size;
+        return std::malloc(size);
+    }
+
+    void*& head = freeLists[size / Alignment - 1];
+    if (head) {
+        void* ptr = head;
+        head = *static_cast<void**>(ptr);
+        return ptr;
+    }
+
+    return bump(size);
+}
+
+void
+Arena::
+free(void* ptr, size_t size)
+{
+    if (!ptr) return;
+    size = blockSize(std::max<size_t>(size, 1));
+
+    std::lock_guard<std::mutex> guard(lock);
+    used_ -= size;
+
+    if (size > MaxBlock) {
+        memory_ -= size;
+        std::free(ptr);
+        return;
+    }
+
+    void*& head = freeLists[size / Alignment - 1];
+    *static_cast<void**>(ptr) = head;
+    head = ptr;
+}
+
+const std::string&
+Arena::
+intern(const std::string& str)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = strings.insert(str).first;
+    return *it;
+}
+
+Span<const Argument>
+Arena::
+intern(const Argument* args, size_t size)
+{
+    if (!size) return Span<const Argument>();
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto& bucket = argLists[hashArguments(args, size)];
+    for (const auto& list : bucket) {
+        if (list.size() != size) continue;
+        if (std::equal(args, args + size, list.begin())) return list;
+    }
+
+    size_t bytes = blockSize(size * sizeof(Argument));
+    used_ += bytes;
+
+    Argument* data = static_cast<Argument*>(bump(bytes));
+    std::uninitialized_copy(args, args + size, data);
+
+    bucket.emplace_back(data, size);
+    return bucket.back();
+}
+
+size_t
+Arena::
+memory() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return memory_;
+}
+
+size_t
+Arena::
+used() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return used_;
+}
+
+} // reflect
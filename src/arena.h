@@ -0,0 +1,68 @@
+/* arena.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Registry-owned arena for function metadata.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* ARENA                                                                      */
+/******************************************************************************/
+
+/** Packs the small and long-lived bits of function metadata (thunks, names and
+    argument lists) into large contiguous chunks instead of scattering them
+    across the heap. Names and argument lists are interned and therefore
+    shared between all the functions that use them. Freed blocks are recycled
+    through per-size free lists but chunks are never returned to the system.
+
+    Accessed through Registry::arena() and safe to use concurrently.
+ */
+struct Arena
+{
+    enum {
+        ChunkSize = 64 * 1024,
+        Alignment = 16,
+        MaxBlock = 1024,
+    };
+
+    Arena();
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Blocks larger than MaxBlock are forwarded to malloc.
+    void* alloc(size_t size);
+    void free(void* ptr, size_t size);
+
+    const std::string& intern(const std::string& str);
+    Span<const Argument> intern(const Argument* args, size_t size);
+
+    // Bytes reserved from the system and bytes currently handed out.
+    size_t memory() const;
+    size_t used() const;
+
+private:
+    void* bump(size_t size);
+
+    mutable std::mutex lock;
+
+    std::vector<void*> chunks;
+    uint8_t* pos;
+    uint8_t* end;
+
+    void* freeLists[MaxBlock / Alignment];
+
+    std::unordered_set<std::string> strings;
+    std::unordered_map< size_t, std::vector< Span<const Argument> > > argLists;
+
+    size_t memory_;
+    size_t used_;
+};
+
+} // reflect
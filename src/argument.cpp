@@ -106,6 +106,13 @@ isConvertibleTo(const Argument& target) const
         return Match::None;
     }
 
+    // Same rule as the copy path of cast().
+    if (target.refType() == RefType::Copy && type() != target.type()) {
+        NumberKind from = type()->numberKind();
+        if (isWideningNumber(from, target.type()->numberKind()))
+            return Match::Partial;
+    }
+
     if (target.refType() != RefType::Copy) {
         if (!testConstConversion(isConst(), target.isConst()))
             return Match::None;
@@ -13,12 +13,20 @@ namespace reflect {
 
 namespace {
 
-Value lref(Value &value, const Argument& target)
+StatusCode lref(Value &value, const Argument& target, Value& out)
 {
+    // The caller holds on to the original value for as long as the reference
+    // is in use so there's no need to share its ownership.
     if (target.type()->isParentOf(value.type())) {
-        if (target.isConst()) return value;
-        if (!value.isConst() && value.refType() == RefType::LValue)
-            return value;
+        if (target.isConst()) {
+            out = value.borrow();
+            return StatusCode::Ok;
+        }
+
+        if (!value.isConst() && value.refType() == RefType::LValue) {
+            out = value.borrow();
+            return StatusCode::Ok;
+        }
     }
 
     // While this is allowed in C++, we can't return a reference to a value that
@@ -26,42 +34,60 @@ Value lref(Value &value, const Argument& target)
     //
     // No idea how to solve this issue unfortunately so it's disabled for now.
     if (false && target.isConst()) {
-        if (value.type()->hasConverter(target.type()))
-            return value.convert<Value>(target.type());
+        if (value.type()->hasConverter(target.type())) {
+            out = value.convert<Value>(target.type());
+            return StatusCode::Ok;
+        }
     }
 
-    reflectError("<%s> is not castable to <%s>",
-            value.argument().print(), target.print());
+    return StatusCode::NotCastable;
 }
 
-Value rref(Value& value, const Argument& target)
+StatusCode rref(Value& value, const Argument& target, Value& out)
 {
     if (target.type()->isMovable()) {
 
-        if (value.type()->isChildOf(target.type()))
-            return value;
+        if (value.type()->isChildOf(target.type())) {
+            out = value.borrow();
+            return StatusCode::Ok;
+        }
 
-        if (value.type()->hasConverter(target.type()))
-            return value.convert<Value>(target.type());
+        if (value.type()->hasConverter(target.type())) {
+            out = value.convert<Value>(target.type());
+            return StatusCode::Ok;
+        }
     }
 
-    reflectError("<%s> is not movable to <%s>",
-            value.argument().print(), target.print());
+    return StatusCode::NotMovable;
 }
 
-Value copy(Value& value, const Argument& target)
+StatusCode copy(Value& value, const Argument& target, Value& out)
 {
-    if (target.type()->isCopiable()) {
+    const Type* type = target.type();
+
+    // Value::copy() takes care of the memcpy path for trivial types.
+    if (value.type()->isChildOf(type)) {
+        if (type->isTriviallyCopyable() || type->isCopiable()) {
+            out = value.copy(type);
+            return StatusCode::Ok;
+        }
+    }
+
+    NumberRef number = numberRef(value);
+    if (isWideningNumber(number.kind, type->numberKind())) {
+        out = widenNumber(number, type->numberKind());
+        return StatusCode::Ok;
+    }
 
-        if (value.type()->isChildOf(target.type()))
-            return target.type()->construct(value);
+    if (target.type()->isCopiable()) {
 
-        if (value.type()->hasConverter(target.type()))
-            return value.convert<Value>(target.type());
+        if (value.type()->hasConverter(target.type())) {
+            out = value.convert<Value>(target.type());
+            return StatusCode::Ok;
+        }
     }
 
-    reflectError("<%s> is not copiable to <%s>",
-            value.argument().print(), target.print());
+    return StatusCode::NotCopiable;
 }
 
 } // namespace anonymous
@@ -83,15 +109,47 @@ bool isCastable(const Value& value, const Argument& target)
     return value.argument().isConvertibleTo(target) != Match::None;
 }
 
-Value cast(Value& value, const Argument& target)
+namespace {
+
+StatusCode castTo(Value& value, const Argument& target, Value& out)
 {
     switch (target.refType()) {
-    case RefType::LValue: return lref(value, target);
-    case RefType::RValue: return rref(value, target);
-    case RefType::Copy:   return copy(value, target);
+    case RefType::LValue: return lref(value, target, out);
+    case RefType::RValue: return rref(value, target, out);
+    case RefType::Copy:   return copy(value, target, out);
     default: reflectUnreachable();
     }
 }
 
+} // namespace anonymous
+
+Status tryCast(const Value& value, const Argument& target, Value& out)
+{
+    StatusCode code = castTo(const_cast<Value&>(value), target, out);
+    if (code == StatusCode::Ok) return Status();
+    return Status(code, target.type());
+}
+
+Value cast(Value& value, const Argument& target)
+{
+    Value result;
+
+    switch (castTo(value, target, result)) {
+    case StatusCode::Ok: return result;
+
+    case StatusCode::NotCastable:
+        reflectError("<%s> is not castable to <%s>",
+                value.argument().print(), target.print());
+
+    case StatusCode::NotMovable:
+        reflectError("<%s> is not movable to <%s>",
+                value.argument().print(), target.print());
+
+    default:
+        reflectError("<%s> is not copiable to <%s>",
+                value.argument().print(), target.print());
+    }
+}
+
 
 } // namespace reflect
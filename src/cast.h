@@ -37,6 +37,9 @@ struct TargetRef
 bool isCastable(const Value& value, const Argument& target);
 Value cast(Value& value, const Argument& target);
 
+// Non-throwing version of cast() which stores the result in out.
+Status tryCast(const Value& value, const Argument& target, Value& out);
+
 template<typename T, typename Target>
 struct Cast
 {
@@ -59,12 +62,28 @@ struct Cast<Value, Target>
         return reflect::isCastable(value, Argument::make<Target>());
     }
 
-    static TargetRef cast(Value value)
+    // Taken by reference since a reference into a temporary must point to
+    // its inline storage and not to a copy of it.
+    static TargetRef cast(Value& value)
     {
+        // Copies of the exact type are made straight from the source which
+        // also avoids storing an intermediate copy on the heap.
+        if (isCopy::value && value.type() == type<CleanTarget>())
+            return ret(value, retLValue(), retRValue(), retCopy());
+
         Value result = reflect::cast(value, Argument::make<Target>());
         return ret(result, retLValue(), retRValue(), retCopy());
     }
 
+    static TargetRef cast(Value&& value) { return cast(value); }
+
+    // Borrowed so that references point into the caller's Value.
+    static TargetRef cast(const Value& value)
+    {
+        Value borrowed = value.borrow();
+        return cast(borrowed);
+    }
+
 
 private:
 
@@ -72,6 +91,7 @@ private:
     // move-constructor in situations where we don't need em.
 
     typedef typename std::is_lvalue_reference<TargetRef>::type retLValue;
+    typedef std::integral_constant<bool, !std::is_reference<Target>::value> isCopy;
 
     template<typename T0, typename T1>
     static TargetRef ret(Value& value, std::true_type, T0, T1)
@@ -124,9 +144,62 @@ struct Cast<Value, Value>
 {
     template<typename U> static bool isCastable(U&&) { return true; }
 
-    static       Value& cast(      Value&  value) { return value; }
-    static       Value  cast(      Value&& value) { return std::move(value); }
-    static const Value& cast(const Value&  value) { return value; }
+    // Values handed out this way may be temporaries. See IsInlineValue.
+    static Value& cast(Value& value)
+    {
+        value.share();
+        return value;
+    }
+
+    static Value cast(Value&& value)
+    {
+        value.share();
+        return std::move(value);
+    }
+
+    static const Value& cast(const Value& value) { return value; }
+};
+
+template<>
+struct Cast<Value, ValueRef>
+{
+    template<typename U> static bool isCastable(U&&) { return true; }
+
+    static ValueRef cast(const Value& value) { return ValueRef(value); }
+};
+
+// Goes through a borrowed Value which doesn't touch any refcounts.
+template<typename Target>
+struct Cast<ValueRef, Target>
+{
+    typedef typename details::TargetRef<Target>::type TargetRef;
+
+    static bool isCastable(const ValueRef& value)
+    {
+        return reflect::isCastable(value.toValue(), Argument::make<Target>());
+    }
+
+    static TargetRef cast(const ValueRef& value)
+    {
+        Value borrowed = value.toValue();
+        return Cast<Value, Target>::cast(borrowed);
+    }
+};
+
+template<>
+struct Cast<ValueRef, Value>
+{
+    template<typename U> static bool isCastable(U&&) { return true; }
+
+    static Value cast(const ValueRef& value) { return value.toValue(); }
+};
+
+template<>
+struct Cast<ValueRef, ValueRef>
+{
+    template<typename U> static bool isCastable(U&&) { return true; }
+
+    static ValueRef cast(const ValueRef& value) { return value; }
 };
 
 template<typename T>
@@ -155,6 +228,25 @@ auto cast(T&& value) ->
 }
 
 
+/** Non-throwing equivalent of out = cast<Target>(value). Values of the exact
+    type are assigned directly without going through an intermediate Value.
+ */
+template<typename Target>
+Status tryCast(const Value& value, Target& out)
+{
+    if (value.type() == type<Target>()) {
+        out = *static_cast<const Target*>(value.value());
+        return Status();
+    }
+
+    Value result;
+    Status status = tryCast(value, Argument::make<Target>(), result);
+    if (status) out = std::move(result.as<Target>());
+
+    return status;
+}
+
+
 /******************************************************************************/
 /* RET CAST                                                                   */
 /******************************************************************************/
@@ -26,6 +26,61 @@ void reflectSizeof(Type* type)
     reflect::reflectSizeof<T_>(type_)
 
 
+/******************************************************************************/
+/* ALIGNOF                                                                    */
+/******************************************************************************/
+
+template<typename T>
+void reflectAlignof(Type* type)
+{
+    type->addTrait("alignof", alignof(T));
+}
+
+#define reflectAlignof() \
+    reflect::reflectAlignof<T_>(type_)
+
+
+/******************************************************************************/
+/* TRIVIAL                                                                    */
+/******************************************************************************/
+
+// The memcpy fast paths stand in for the copy constructor and the copy
+// assignment operator so both must be usable.
+template<typename T,
+    class = typename std::enable_if<
+        std::is_trivially_copyable<T>::value &&
+        std::is_copy_constructible<T>::value &&
+        std::is_copy_assignable<T>::value>::type>
+void reflectTrivial(Type* type)
+{
+    type->addTrait("trivial");
+}
+
+template<typename>
+void reflectTrivial(...) {}
+
+#define reflectTrivial() \
+    reflect::reflectTrivial<T_>(type_)
+
+
+/******************************************************************************/
+/* DESTRUCTOR                                                                 */
+/******************************************************************************/
+
+template<typename T,
+    class = typename std::enable_if<std::is_destructible<T>::value>::type>
+void reflectDestructor(Type* type)
+{
+    type->setDestructor([] (void* obj) { static_cast<T*>(obj)->~T(); });
+}
+
+template<typename>
+void reflectDestructor(...) {}
+
+#define reflectDestructor() \
+    reflect::reflectDestructor<T_>(type_)
+
+
 /******************************************************************************/
 /* CONS DEFAULT                                                               */
 /******************************************************************************/
@@ -197,6 +252,9 @@ void reflectMoveAssignOperator(...) {}
 #define reflectPlumbing()                               \
     do {                                                \
         reflectSizeof();                                \
+        reflectAlignof();                               \
+        reflectTrivial();                               \
+        reflectDestructor();                            \
         reflectDefaultCons();                           \
         reflectCopyCons();                              \
         reflectOpCopyAssign();                          \
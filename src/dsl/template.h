@@ -14,13 +14,13 @@ namespace reflect {
 /* REFLECT TEMPLATE LOADER                                                    */
 /******************************************************************************/
 
-#define reflectTemplateLoader()                 \
-    static void loader()                        \
-    {                                           \
-        static bool loaded = false;             \
-        if (loaded) return;                     \
-        loaded = true;                          \
-        Registry::add<T_>();                    \
+// Function statics are initialized exactly once even when multiple threads
+// race to the first call.
+#define reflectTemplateLoader()                                 \
+    static void loader()                                        \
+    {                                                           \
+        static reflectUnused bool loaded =                      \
+            (Registry::add<T_>(), true);                        \
     }
 
 
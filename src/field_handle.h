@@ -0,0 +1,74 @@
+/* field_handle.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Precompiled field accessor.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* FIELD HANDLE                                                               */
+/******************************************************************************/
+
+/** Resolves a field of a type once and then accesses it through a raw pointer
+    add which avoids the name lookup, the constness checks and the Value
+    construction done by Value::field.
+
+    All the checks are done when the handle is created: the field must exist,
+    its type must be exactly T and a non-const T can't be used to access a
+    const field. The raw pointer accessors don't check anything so the object
+    passed in must be an instance of owner() (or of a child that doesn't move
+    it). The Value accessors check the type and the constness of the Value.
+ */
+template<typename T>
+struct FieldHandle
+{
+    typedef typename std::remove_reference<T>::type ValueT;
+
+    FieldHandle() : owner_(nullptr), offset_(0), isConst_(false) {}
+    FieldHandle(const Type* owner, const std::string& field);
+
+    const Type* owner() const { return owner_; }
+    size_t offset() const { return offset_; }
+    bool isConst() const { return isConst_; }
+
+    explicit operator bool() const { return owner_; }
+
+    ValueT& get(void* obj) const
+    {
+        return *reinterpret_cast<ValueT*>(static_cast<uint8_t*>(obj) + offset_);
+    }
+
+    const ValueT& get(const void* obj) const
+    {
+        return *reinterpret_cast<const ValueT*>(
+                static_cast<const uint8_t*>(obj) + offset_);
+    }
+
+    ValueT& get(const Value& obj) const
+    {
+        return get(check(obj, !std::is_const<ValueT>::value));
+    }
+
+    template<typename Arg>
+    void set(void* obj, Arg&& value) const;
+
+    template<typename Arg>
+    void set(const Value& obj, Arg&& value) const
+    {
+        set(check(obj, true), std::forward<Arg>(value));
+    }
+
+private:
+    void* check(const Value& obj, bool write) const;
+
+    const Type* owner_;
+    size_t offset_;
+    bool isConst_;
+};
+
+} // reflect
@@ -0,0 +1,68 @@
+/* field_handle.tcc                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Template implementation of FieldHandle.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* FIELD HANDLE                                                               */
+/******************************************************************************/
+
+template<typename T>
+FieldHandle<T>::
+FieldHandle(const Type* owner, const std::string& name) :
+    owner_(owner), offset_(0), isConst_(false)
+{
+    const Field& field = owner->field(name);
+
+    if (field.type() != type<T>()) {
+        reflectError("field <%s::%s> of type <%s> can't be accessed as <%s>",
+                owner->id(), name, field.type()->id(), printArgument<T>());
+    }
+
+    isConst_ = field.argument().isConst();
+    if (isConst_ && !std::is_const<ValueT>::value) {
+        reflectError("const field <%s::%s> can't be accessed as <%s>",
+                owner->id(), name, printArgument<T>());
+    }
+
+    offset_ = field.offset();
+}
+
+template<typename T>
+void*
+FieldHandle<T>::
+check(const Value& obj, bool write) const
+{
+    if (!obj.type()->isChildOf(owner_)) {
+        reflectError("<%s> is not a child of <%s>",
+                obj.type()->id(), owner_->id());
+    }
+
+    if (write && obj.isConst()) {
+        reflectError("field of const <%s> can't be accessed as <%s>",
+                obj.type()->id(), printArgument<T>());
+    }
+
+    return obj.value();
+}
+
+template<typename T>
+template<typename Arg>
+void
+FieldHandle<T>::
+set(void* obj, Arg&& value) const
+{
+    static_assert(!std::is_const<ValueT>::value,
+            "can't set a field through a const handle");
+
+    get(obj) = std::forward<Arg>(value);
+}
+
+} // namespace reflect
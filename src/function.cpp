@@ -19,9 +19,11 @@ namespace reflect {
 Function::
 Function(Function&& other) noexcept :
     fn(other.fn),
-    name_(std::move(other.name_)),
-    ret(std::move(other.ret)),
-    args(std::move(other.args))
+    native(other.native),
+    nativeType(other.nativeType),
+    name_(other.name_),
+    args(other.args),
+    ret(std::move(other.ret))
 {
     other.fn = nullptr;
 }
@@ -35,9 +37,12 @@ operator=(Function&& other) noexcept
     fn = other.fn;
     other.fn = nullptr;
 
-    name_ = std::move(other.name_);
+    native = other.native;
+    nativeType = other.nativeType;
+
+    name_ = other.name_;
+    args = other.args;
     ret = std::move(other.ret);
-    args = std::move(other.args);
 
     return *this;
 }
@@ -48,6 +53,25 @@ Function::
     if (fn) freeValueFunction(fn);
 }
 
+void
+Function::
+assignSlot(void* slot, Value result) const
+{
+    // Stored results are temporaries that can be moved from.
+    if (result.isStored()) result = result.rvalue();
+
+    Argument target(ret.type(), RefType::LValue, false);
+    ValueRef(target, slot).toValue().assign(result);
+}
+
+void
+Function::
+constructSlot(void* slot, const Value& result) const
+{
+    // Goes through the type's copy constructor which returns by value.
+    ret.type()->constructAt(slot, result);
+}
+
 Match
 Function::
 testReturn(const Argument& value, const Argument& target) const
@@ -73,15 +97,13 @@ testReturn(const Argument& value, const Argument& target) const
 
 Match
 Function::
-testArguments(
-        const std::vector<Argument>& value,
-        const std::vector<Argument>& target) const
+testArguments(const Argument* value, size_t size) const
 {
-    if (value.size() != target.size()) return Match::None;
+    if (size != args.size()) return Match::None;
 
     Match match = Match::Exact;
-    for (size_t i = 0; i < target.size(); ++i) {
-        match = combine(match, value[i].isConvertibleTo(target[i]));
+    for (size_t i = 0; i < size; ++i) {
+        match = combine(match, value[i].isConvertibleTo(args[i]));
         if (match == Match::None) return Match::None;
     }
 
@@ -94,16 +116,23 @@ test(const Function& other) const
 {
     return combine(
             testReturn(other.ret, ret),
-            testArguments(other.args, args));
+            testArguments(other.args.data(), other.args.size()));
 }
 
 Match
 Function::
 test(const Argument& ret, const std::vector<Argument>& args) const
+{
+    return test(ret, args.data(), args.size());
+}
+
+Match
+Function::
+test(const Argument& ret, const Argument* args, size_t size) const
 {
     return combine(
             testReturn(ret, this->ret),
-            testArguments(args, this->args));
+            testArguments(args, size));
 }
 
 
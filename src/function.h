@@ -25,6 +25,8 @@ std::vector<Argument> reflectArguments(Args&&... args);
 /* FUNCTION                                                                   */
 /******************************************************************************/
 
+template<typename Fn> struct Invoker;
+
 struct Function
 {
     template<typename Fn>
@@ -36,7 +38,7 @@ struct Function
     Function(Function&&) noexcept;
     Function& operator=(Function&&) noexcept;
 
-    const std::string& name() const { return name_; }
+    const std::string& name() const { return *name_; }
 
     const Argument& returnType() const { return ret; }
 
@@ -47,6 +49,7 @@ struct Function
     Match test() const;
     Match test(const Function& other) const;
     Match test(const Argument& ret, const std::vector<Argument>& args) const;
+    Match test(const Argument& ret, const Argument* args, size_t size) const;
 
     template<typename Ret, typename... Args>
     Match testParams(Args&&... args) const;
@@ -54,19 +57,94 @@ struct Function
     template<typename Ret, typename... Args>
     Ret call(Args&&... args) const;
 
+    /** Assigns the return value into slot which must point to a live object
+        of the clean return type. Since the type of slot is only known at
+        runtime, the result is boxed in a Value and assigned through the
+        type's reflected operator=. Prefer the typed version where possible.
+     */
+    template<typename... Args>
+    void callInto(void* slot, Args&&... args) const;
+
+    /** If Ret is the clean return type then a result returned by value is
+        constructed on the stack and moved into out while a returned reference
+        is copied into out. Either way the result is never boxed in a Value
+        which, for non-scalar returns, saves an allocation. Falls back to a
+        regular call otherwise.
+     */
+    template<typename Ret, typename... Args>
+    void callInto(Ret& out, Args&&... args) const;
+
+    /** Constructs the return value directly in the uninitialized memory
+        pointed to by slot which must be sized and aligned for the clean
+        return type. The caller is responsible for destroying the object.
+     */
+    template<typename... Args>
+    void constructInto(void* slot, Args&&... args) const;
+
+    template<typename Fn>
+    Invoker<Fn> bind() const;
+
+    template<typename Fn>
+    bool isNative() const;
+
 private:
+    friend struct Overloads;
+    template<typename Fn> friend struct Invoker;
+
+    // Dispatches without checking the arguments which is only safe once the
+    // call has been resolved against this function.
+    template<typename Ret, typename... Args>
+    Ret invoke(Args&&... args) const;
+
+    // Calls the function through its ValueFunction. See
+    // ValueFunctionBase::invoke for slot.
+    template<typename... Args>
+    Value dispatch(void* slot, Args&&... args) const;
+
+    // Scalars passed as rvalues only live for the duration of the call so
+    // they're kept inline. See IsInlineValue.
+    template<typename T>
+    struct IsTemporaryArg : public std::integral_constant<bool,
+        !std::is_lvalue_reference<T>::value && IsInlineValue<T>::value>
+    {};
+
+    template<typename T>
+    static Value temporary(T&& arg, std::true_type);
+
+    template<typename T>
+    static auto temporary(T&& arg, std::false_type) ->
+        decltype(cast<Value>(std::forward<T>(arg)));
+
+    // Ret must be the clean return type of the function.
+    template<typename Ret, typename... Args>
+    void invokeInto(Ret& out, Args&&... args) const;
+
+    template<typename... Args>
+    void invokeConstructInto(void* slot, Args&&... args) const;
+
+    // Slow paths for slots whose type is only known at runtime.
+    void assignSlot(void* slot, Value result) const;
+    void constructSlot(void* slot, const Value& result) const;
+
+    template<typename Ret>
+    bool isReturnSlot() const;
 
     Match test(const Argument& value, const Argument& target) const;
     Match testReturn(const Argument& value, const Argument& target) const;
-    Match testArguments(
-            const std::vector<Argument>& value,
-            const std::vector<Argument>& target) const;
+    Match testArguments(const Argument* value, size_t size) const;
 
     void* fn;
-    std::string name_;
+
+    // Function or member function pointer stored in fn and its type which
+    // Invoker uses to call it directly. Both are null for functors.
+    const void* native;
+    const std::type_info* nativeType;
+
+    // Both interned in Registry::arena().
+    const std::string* name_;
+    Span<const Argument> args;
 
     Argument ret;
-    std::vector<Argument> args;
 };
 
 
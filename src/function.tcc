@@ -64,6 +64,15 @@ std::vector<Argument> reflectArguments()
     return args;
 }
 
+inline void reflectArguments(Argument*, TypeVector<>) {}
+
+template<typename Arg, typename... Rest>
+void reflectArguments(Argument* args, TypeVector<Arg, Rest...>)
+{
+    *args = Argument::make<Arg>();
+    reflectArguments(args + 1, TypeVector<Rest...>());
+}
+
 
 /******************************************************************************/
 /* REFLECT ARGUMENTS                                                          */
@@ -95,6 +104,30 @@ void reflectArguments(
     reflectArguments(args, std::forward<Rest>(rest)...);
 }
 
+template<typename... Rest>
+void reflectArguments(
+        std::vector<Argument>& args, const ValueRef& value, Rest&&... rest)
+{
+    args.emplace_back(value.argument());
+    reflectArguments(args, std::forward<Rest>(rest)...);
+}
+
+template<typename... Rest>
+void reflectArguments(
+        std::vector<Argument>& args, ValueRef& value, Rest&&... rest)
+{
+    args.emplace_back(value.argument());
+    reflectArguments(args, std::forward<Rest>(rest)...);
+}
+
+template<typename... Rest>
+void reflectArguments(
+        std::vector<Argument>& args, ValueRef&& value, Rest&&... rest)
+{
+    args.emplace_back(value.argument());
+    reflectArguments(args, std::forward<Rest>(rest)...);
+}
+
 template<typename Arg, typename... Rest>
 void reflectArguments(std::vector<Argument>& args, Arg&& arg, Rest&&... rest)
 {
@@ -110,19 +143,110 @@ std::vector<Argument> reflectArguments(Args&&... args)
     return result;
 }
 
+// Array variant which fills the given array with one entry per argument. Used
+// on the call path where we don't want to allocate.
+inline void reflectArguments(Argument*) {}
+
+template<typename... Rest>
+void reflectArguments(Argument* args, Value& value, Rest&&... rest)
+{
+    *args = value.argument();
+    reflectArguments(args + 1, std::forward<Rest>(rest)...);
+}
+
+template<typename... Rest>
+void reflectArguments(Argument* args, const Value& value, Rest&&... rest)
+{
+    *args = value.argument();
+    reflectArguments(args + 1, std::forward<Rest>(rest)...);
+}
+
+template<typename... Rest>
+void reflectArguments(Argument* args, Value&& value, Rest&&... rest)
+{
+    *args = value.argument();
+    reflectArguments(args + 1, std::forward<Rest>(rest)...);
+}
+
+template<typename... Rest>
+void reflectArguments(Argument* args, const ValueRef& value, Rest&&... rest)
+{
+    *args = value.argument();
+    reflectArguments(args + 1, std::forward<Rest>(rest)...);
+}
+
+template<typename... Rest>
+void reflectArguments(Argument* args, ValueRef& value, Rest&&... rest)
+{
+    *args = value.argument();
+    reflectArguments(args + 1, std::forward<Rest>(rest)...);
+}
+
+template<typename... Rest>
+void reflectArguments(Argument* args, ValueRef&& value, Rest&&... rest)
+{
+    *args = value.argument();
+    reflectArguments(args + 1, std::forward<Rest>(rest)...);
+}
+
+template<typename Arg, typename... Rest>
+void reflectArguments(Argument* args, Arg&& arg, Rest&&... rest)
+{
+    *args = Argument::make(std::forward<Arg>(arg));
+    reflectArguments(args + 1, std::forward<Rest>(rest)...);
+}
+
+
+/******************************************************************************/
+/* VALUE ARG                                                                  */
+/******************************************************************************/
+
+// Binds any flavour of Value to the parameters of ValueFunction without a
+// copy. Safe because ValueFunction never moves out of its arguments.
+inline Value&& valueArg(Value& value) { return std::move(value); }
+inline Value&& valueArg(Value&& value) { return std::move(value); }
+
+inline Value&& valueArg(const Value& value)
+{
+    return std::move(const_cast<Value&>(value));
+}
+
 
 /******************************************************************************/
 /* FUNCTION                                                                   */
 /******************************************************************************/
 
+namespace details {
+
+template<typename Fn>
+const std::type_info* nativeType(GlobalFunction) { return &typeid(Fn); }
+
+template<typename Fn>
+const std::type_info* nativeType(MemberFunction) { return &typeid(Fn); }
+
+template<typename Fn>
+const std::type_info* nativeType(FunctorFunction) { return nullptr; }
+
+} // namespace details
+
 template<typename Fn>
 Function::
 Function(const std::string& name, Fn fn) :
     fn(makeValueFunction(std::move(fn))),
-    name_(name)
+    name_(&Registry::arena().intern(name))
 {
+    typedef FunctionType<Fn> FnType;
+
+    typedef MakeValueFunction<Fn> Make;
+    native = static_cast<typename Make::type*>(this->fn)->native();
+    nativeType = details::nativeType<typename Make::StoredFn>(
+            typename Make::FnType::type());
+
+    Argument argsArray[FnType::ArgCount + 1];
+    reflectArguments(argsArray, typename FnType::Arguments());
+    args = Registry::arena().intern(argsArray, FnType::ArgCount);
+
     ret = reflectReturn<Fn>();
-    args = reflectArguments<Fn>();
 }
 
 
@@ -131,12 +255,15 @@ Match
 Function::
 test() const
 {
-    auto otherRet = reflectReturn<Fn>();
-    auto otherArgs = reflectArguments<Fn>();
+    typedef FunctionType<Fn> FnType;
+
+    // The extra slot avoids a zero-sized array for functions without arguments.
+    Argument otherArgs[FnType::ArgCount + 1];
+    reflectArguments(otherArgs, typename FnType::Arguments());
 
     return combine(
-            testReturn(otherRet, ret),
-            testArguments(otherArgs, args));
+            testReturn(reflectReturn<Fn>(), ret),
+            testArguments(otherArgs, FnType::ArgCount));
 }
 
 template<typename Ret, typename... Args>
@@ -144,12 +271,12 @@ Match
 Function::
 testParams(Args&&... args) const
 {
-    auto otherRet = reflectReturn<Ret(Args...)>();
-    auto otherArgs = reflectArguments(std::forward<Args>(args)...);
+    Argument otherArgs[sizeof...(Args) + 1];
+    reflectArguments(otherArgs, std::forward<Args>(args)...);
 
     return combine(
-            testReturn(otherRet, ret),
-            testArguments(otherArgs, this->args));
+            testReturn(Argument::make<Ret>(), ret),
+            testArguments(otherArgs, sizeof...(Args)));
 }
 
 template<typename Ret, typename... Args>
@@ -162,11 +289,185 @@ call(Args&&... args) const
                 signature<Ret(Args...)>(), signature(*this));
     }
 
+    return invoke<Ret>(std::forward<Args>(args)...);
+}
+
+template<typename Ret, typename... Args>
+Ret
+Function::
+invoke(Args&&... args) const
+{
+    return retCast<Ret>(dispatch(nullptr, std::forward<Args>(args)...));
+}
+
+template<typename... Args>
+Value
+Function::
+dispatch(void* slot, Args&&... args) const
+{
     typedef ValueFunction<sizeof...(Args)> Fn;
     Fn& typedFn = *static_cast<Fn*>(fn);
 
-    Value ret = typedFn(cast<Value>(std::forward<Args>(args))...);
-    return retCast<Ret>(ret);
+    return typedFn.invoke(slot, valueArg(temporary(std::forward<Args>(args),
+                            typename IsTemporaryArg<Args>::type()))...);
+}
+
+template<typename T>
+Value
+Function::
+temporary(T&& arg, std::true_type)
+{
+    return Value::temporary(std::forward<T>(arg));
+}
+
+template<typename T>
+auto
+Function::
+temporary(T&& arg, std::false_type) ->
+    decltype(cast<Value>(std::forward<T>(arg)))
+{
+    return cast<Value>(std::forward<T>(arg));
+}
+
+template<typename... Args>
+void
+Function::
+callInto(void* slot, Args&&... args) const
+{
+    Argument otherArgs[sizeof...(Args) + 1];
+    reflectArguments(otherArgs, std::forward<Args>(args)...);
+
+    Match match = testArguments(otherArgs, sizeof...(Args));
+    if (ret.isVoid() || match == Match::None) {
+        reflectError("<%s> is not convertible to <%s>",
+                signature<void(Args...)>(), signature(*this));
+    }
+
+    assignSlot(slot, dispatch(nullptr, std::forward<Args>(args)...));
+}
+
+template<typename Ret, typename... Args>
+void
+Function::
+callInto(Ret& out, Args&&... args) const
+{
+    if (!isReturnSlot<Ret>()) {
+        out = call<Ret>(std::forward<Args>(args)...);
+        return;
+    }
+
+    Argument otherArgs[sizeof...(Args) + 1];
+    reflectArguments(otherArgs, std::forward<Args>(args)...);
+
+    if (testArguments(otherArgs, sizeof...(Args)) == Match::None) {
+        reflectError("<%s> is not convertible to <%s>",
+                signature<void(Args...)>(), signature(*this));
+    }
+
+    invokeInto(out, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+void
+Function::
+constructInto(void* slot, Args&&... args) const
+{
+    Argument otherArgs[sizeof...(Args) + 1];
+    reflectArguments(otherArgs, std::forward<Args>(args)...);
+
+    Match match = testArguments(otherArgs, sizeof...(Args));
+    if (ret.isVoid() || match == Match::None) {
+        reflectError("<%s> is not convertible to <%s>",
+                signature<void(Args...)>(), signature(*this));
+    }
+
+    invokeConstructInto(slot, std::forward<Args>(args)...);
+}
+
+namespace details {
+
+// Holds the result of a function until it's moved into the caller's object.
+template<typename T>
+struct ReturnSlot
+{
+    ReturnSlot() : live(false) {}
+    ~ReturnSlot() { if (live) get().~T(); }
+
+    T& get() { return *reinterpret_cast<T*>(&storage); }
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    bool live;
+};
+
+template<typename Ret>
+void assignRef(Ret& out, const Value& value, std::true_type)
+{
+    out = value.get<Ret>();
+}
+
+template<typename Ret>
+void assignRef(Ret& out, const Value& value, std::false_type)
+{
+    out = retCast<Ret>(value);
+}
+
+} // namespace details
+
+template<typename Ret, typename... Args>
+void
+Function::
+invokeInto(Ret& out, Args&&... args) const
+{
+    if (ret.refType() != RefType::Copy) {
+        Value value = dispatch(nullptr, std::forward<Args>(args)...);
+        details::assignRef(out, value, std::is_copy_assignable<Ret>());
+        return;
+    }
+
+    details::ReturnSlot<Ret> slot;
+    dispatch(&slot.storage, std::forward<Args>(args)...);
+    slot.live = true;
+
+    out = std::move(slot.get());
+}
+
+template<typename... Args>
+void
+Function::
+invokeConstructInto(void* slot, Args&&... args) const
+{
+    if (ret.refType() != RefType::Copy)
+        constructSlot(slot, dispatch(nullptr, std::forward<Args>(args)...));
+    else dispatch(slot, std::forward<Args>(args)...);
+}
+
+template<typename Ret>
+bool
+Function::
+isReturnSlot() const
+{
+    reflectStaticAssert(!std::is_const<Ret>::value);
+    return ret.type() == type<Ret>();
+}
+
+template<typename Fn>
+Invoker<Fn>
+Function::
+bind() const
+{
+    return Invoker<Fn>(*this);
+}
+
+template<typename Fn>
+bool
+Function::
+isNative() const
+{
+    typedef typename std::add_pointer<Fn>::type Pointer;
+    typedef typename MemberPointer<Fn>::type Member;
+
+    if (!nativeType) return false;
+    return *nativeType == typeid(Pointer) || *nativeType == typeid(Member);
 }
 
 } // reflect
@@ -122,4 +122,40 @@ struct FunctionType<Ret(Obj::*)(Args...) const>
     typedef Ret (Fn)(const Obj&, Args...);
 };
 
+
+/******************************************************************************/
+/* MEMBER POINTER                                                             */
+/******************************************************************************/
+
+namespace details {
+
+template<typename Obj, typename Ret, typename... Args>
+struct MemberPointerOf
+{
+    typedef Ret (Obj::*type)(Args...);
+};
+
+template<typename Obj, typename Ret, typename... Args>
+struct MemberPointerOf<const Obj, Ret, Args...>
+{
+    typedef Ret (Obj::*type)(Args...) const;
+};
+
+} // namespace details
+
+/** Member function pointer type whose FunctionType<>::Fn is the given native
+    signature or void if the signature can't belong to a member function.
+ */
+template<typename Fn, typename Enable = void>
+struct MemberPointer
+{
+    typedef void type;
+};
+
+template<typename Obj, typename Ret, typename... Args>
+struct MemberPointer<Ret(Obj&, Args...),
+        typename std::enable_if<std::is_class<Obj>::value>::type> :
+        public details::MemberPointerOf<Obj, Ret, Args...>
+{};
+
 } // reflect
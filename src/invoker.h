@@ -0,0 +1,61 @@
+/* invoker.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Pre-bound typed invoker for reflected functions.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* INVOKER                                                                    */
+/******************************************************************************/
+
+/** Callable bound to a single reflected function for the signature Fn. All the
+    checks are done when the invoker is created.
+
+    If the function is a function pointer, a member function pointer or a
+    lambda without captures and Fn is exactly its native signature then calls
+    go straight to the underlying function without ever creating a Value which
+    costs about as much as calling through a std::function. Otherwise the
+    arguments are boxed into Values and dispatched through the function's
+    generic interface but overload resolution and argument checks are still
+    skipped.
+
+    The invoker must not outlive the function it was bound to.
+ */
+template<typename Fn> struct Invoker;
+
+template<typename Ret, typename... Args>
+struct Invoker<Ret(Args...)>
+{
+    Invoker() : thunk(nullptr), target(nullptr), native(false) {}
+    explicit Invoker(const Function& fn);
+
+    explicit operator bool() const { return thunk; }
+    bool isNative() const { return native; }
+
+    Ret operator() (Args... args) const
+    {
+        return thunk(target, std::forward<Args>(args)...);
+    }
+
+private:
+    typedef Ret (*Thunk)(void*, Args...);
+
+    static Thunk memberThunk(std::true_type);
+    static Thunk memberThunk(std::false_type);
+
+    static Ret global(void* fn, Args... args);
+    static Ret member(void* fn, Args... args);
+    static Ret boxed(void* fn, Args... args);
+
+    Thunk thunk;
+    void* target;
+    bool native;
+};
+
+} // namespace reflect
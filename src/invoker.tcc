@@ -0,0 +1,102 @@
+/* invoker.tcc                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Template implementation of Invoker.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* INVOKER                                                                    */
+/******************************************************************************/
+
+template<typename Ret, typename... Args>
+Invoker<Ret(Args...)>::
+Invoker(const Function& fn) :
+    thunk(nullptr), target(nullptr), native(false)
+{
+    typedef typename MemberPointer<Ret(Args...)>::type Member;
+    typedef typename std::is_member_function_pointer<Member>::type IsMember;
+
+    // The thunks are only instantiated here so that reflecting a function
+    // doesn't pay for signatures that are never bound.
+    if (fn.nativeType && *fn.nativeType == typeid(Ret(*)(Args...)))
+        thunk = &global;
+
+    else if (fn.nativeType && *fn.nativeType == typeid(Member))
+        thunk = memberThunk(IsMember());
+
+    if (thunk) {
+        target = const_cast<void*>(fn.native);
+        native = true;
+        return;
+    }
+
+    if (fn.test<Ret(Args...)>() == Match::None) {
+        reflectError("<%s> is not convertible to <%s>",
+                signature<Ret(Args...)>(), signature(fn));
+    }
+
+    thunk = &boxed;
+    target = const_cast<Function*>(&fn);
+}
+
+template<typename Ret, typename... Args>
+Ret
+Invoker<Ret(Args...)>::
+global(void* fn, Args... args)
+{
+    typedef Ret (*Fn)(Args...);
+    return (*static_cast<Fn*>(fn))(std::forward<Args>(args)...);
+}
+
+template<typename Ret, typename... Args>
+auto
+Invoker<Ret(Args...)>::
+memberThunk(std::true_type) -> Thunk
+{
+    return &member;
+}
+
+template<typename Ret, typename... Args>
+auto
+Invoker<Ret(Args...)>::
+memberThunk(std::false_type) -> Thunk
+{
+    return nullptr;
+}
+
+namespace details {
+
+template<typename Ret, typename Fn, typename Obj, typename... Rest>
+Ret callMember(Fn fn, Obj&& obj, Rest&&... rest)
+{
+    return (obj.*fn)(std::forward<Rest>(rest)...);
+}
+
+} // namespace details
+
+template<typename Ret, typename... Args>
+Ret
+Invoker<Ret(Args...)>::
+member(void* fn, Args... args)
+{
+    typedef typename MemberPointer<Ret(Args...)>::type Fn;
+    return details::callMember<Ret>(
+            *static_cast<Fn*>(fn), std::forward<Args>(args)...);
+}
+
+template<typename Ret, typename... Args>
+Ret
+Invoker<Ret(Args...)>::
+boxed(void* fn, Args... args)
+{
+    const Function* function = static_cast<const Function*>(fn);
+    return function->invoke<Ret>(std::forward<Args>(args)...);
+}
+
+} // namespace reflect
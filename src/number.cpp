@@ -0,0 +1,281 @@
+/* number.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Number kind dispatch.
+*/
+
+#include "reflect.h"
+
+#include <limits>
+
+namespace reflect {
+
+/******************************************************************************/
+/* NUMBER KINDS                                                               */
+/******************************************************************************/
+
+#define reflectNumberKinds(fn)                  \
+    fn(Bool, bool)                              \
+    fn(Char, char)                              \
+    fn(SChar, signed char)                      \
+    fn(UChar, unsigned char)                    \
+    fn(Short, short int)                        \
+    fn(UShort, unsigned short int)              \
+    fn(Int, int)                                \
+    fn(UInt, unsigned int)                      \
+    fn(Long, long int)                          \
+    fn(ULong, unsigned long int)                \
+    fn(LongLong, long long int)                 \
+    fn(ULongLong, unsigned long long int)       \
+    fn(Float, float)                            \
+    fn(Double, double)                          \
+    fn(LongDouble, long double)
+
+std::ostream& operator<<(std::ostream& stream, NumberKind kind)
+{
+    switch (kind)
+    {
+    case NumberKind::None: stream << "None"; break;
+
+#define reflectNumberKindName(kind, T)                          \
+    case NumberKind::kind: stream << #kind; break;
+
+    reflectNumberKinds(reflectNumberKindName)
+
+#undef reflectNumberKindName
+
+    default: reflectError("unknown number kind");
+    };
+
+    return stream;
+}
+
+
+namespace {
+
+/******************************************************************************/
+/* LOAD                                                                       */
+/******************************************************************************/
+
+template<typename T>
+T loadNumber(NumberRef ref)
+{
+    switch (ref.kind)
+    {
+
+#define reflectLoadNumber(kind, Src)                                    \
+    case NumberKind::kind:                                              \
+        return static_cast<T>(*static_cast<const Src*>(ref.value));
+
+    reflectNumberKinds(reflectLoadNumber)
+
+#undef reflectLoadNumber
+
+    default: reflectUnreachable();
+    }
+}
+
+
+/******************************************************************************/
+/* INFO                                                                       */
+/******************************************************************************/
+
+struct NumberInfo
+{
+    bool isInteger;
+    bool isSigned;
+    int digits;
+};
+
+template<typename T>
+NumberInfo numberInfo()
+{
+    typedef std::numeric_limits<T> Limits;
+    return { Limits::is_integer, Limits::is_signed, Limits::digits };
+}
+
+NumberInfo numberInfo(NumberKind kind)
+{
+    switch (kind)
+    {
+
+#define reflectNumberInfo(kind, T)                      \
+    case NumberKind::kind: return numberInfo<T>();
+
+    reflectNumberKinds(reflectNumberInfo)
+
+#undef reflectNumberInfo
+
+    default: reflectUnreachable();
+    }
+}
+
+
+/******************************************************************************/
+/* APPLY                                                                      */
+/******************************************************************************/
+
+template<typename T>
+bool applyIntegerOp(NumberOp op, T lhs, T rhs, Value& out, std::true_type)
+{
+    switch (op)
+    {
+    case NumberOp::Mod: out = Value(lhs % rhs); return true;
+    case NumberOp::And: out = Value(lhs & rhs); return true;
+    case NumberOp::Or:  out = Value(lhs | rhs); return true;
+    case NumberOp::Xor: out = Value(lhs ^ rhs); return true;
+    default: reflectUnreachable();
+    }
+}
+
+template<typename T>
+bool applyIntegerOp(NumberOp, T, T, Value&, std::false_type)
+{
+    return false;
+}
+
+/** Both operands go through the same usual arithmetic conversions that the
+    compiler would apply which also takes care of the integer promotions.
+ */
+template<typename L, typename R>
+bool applyNumberOp(NumberOp op, L rawLhs, R rawRhs, Value& out)
+{
+    typedef decltype(rawLhs + rawRhs) T;
+
+    T lhs = static_cast<T>(rawLhs);
+    T rhs = static_cast<T>(rawRhs);
+
+    bool isDivision = op == NumberOp::Div || op == NumberOp::Mod;
+    if (std::is_integral<T>::value && isDivision && rhs == T(0))
+        reflectError("integer division by zero");
+
+    switch (op)
+    {
+    case NumberOp::Add: out = Value(lhs + rhs); return true;
+    case NumberOp::Sub: out = Value(lhs - rhs); return true;
+    case NumberOp::Mul: out = Value(lhs * rhs); return true;
+    case NumberOp::Div: out = Value(lhs / rhs); return true;
+
+    case NumberOp::Mod:
+    case NumberOp::And:
+    case NumberOp::Or:
+    case NumberOp::Xor:
+        return applyIntegerOp(
+                op, lhs, rhs, out, typename std::is_integral<T>::type());
+
+    case NumberOp::Eq: out = Value(lhs == rhs); return true;
+    case NumberOp::Ne: out = Value(lhs != rhs); return true;
+    case NumberOp::Lt: out = Value(lhs <  rhs); return true;
+    case NumberOp::Gt: out = Value(lhs >  rhs); return true;
+    case NumberOp::Le: out = Value(lhs <= rhs); return true;
+    case NumberOp::Ge: out = Value(lhs >= rhs); return true;
+
+    default: reflectUnreachable();
+    }
+}
+
+template<typename L>
+bool applyNumberOp(NumberOp op, L lhs, NumberRef rhs, Value& out)
+{
+    switch (rhs.kind)
+    {
+
+#define reflectApplyNumberOp(kind, R)                                   \
+    case NumberKind::kind:                                              \
+        return applyNumberOp(op, lhs, *static_cast<const R*>(rhs.value), out);
+
+    reflectNumberKinds(reflectApplyNumberOp)
+
+#undef reflectApplyNumberOp
+
+    default: return false;
+    }
+}
+
+} // namespace anonymous
+
+
+/******************************************************************************/
+/* NUMBER OPS                                                                 */
+/******************************************************************************/
+
+bool numberOp(NumberOp op, NumberRef lhs, NumberRef rhs, Value& out)
+{
+    if (rhs.kind == NumberKind::None) return false;
+
+    switch (lhs.kind)
+    {
+
+#define reflectNumberOp(kind, L)                                        \
+    case NumberKind::kind:                                              \
+        return applyNumberOp(op, *static_cast<const L*>(lhs.value), rhs, out);
+
+    reflectNumberKinds(reflectNumberOp)
+
+#undef reflectNumberOp
+
+    default: return false;
+    }
+}
+
+bool numberConvert(NumberRef value, NumberKind kind, void* out)
+{
+    if (value.kind == NumberKind::None) return false;
+
+    switch (kind)
+    {
+
+#define reflectNumberConvert(kind, T)                                   \
+    case NumberKind::kind:                                              \
+        *static_cast<T*>(out) = loadNumber<T>(value);                   \
+        return true;
+
+    reflectNumberKinds(reflectNumberConvert)
+
+#undef reflectNumberConvert
+
+    default: return false;
+    }
+}
+
+bool numberToBool(NumberRef value)
+{
+    return loadNumber<bool>(value);
+}
+
+bool isWideningNumber(NumberKind from, NumberKind to)
+{
+    if (from == NumberKind::None || to == NumberKind::None) return false;
+    if (from == to) return true;
+
+    NumberInfo src = numberInfo(from);
+    NumberInfo dst = numberInfo(to);
+
+    if (dst.isInteger) {
+        if (!src.isInteger) return false;
+        if (src.isSigned && !dst.isSigned) return false;
+    }
+
+    return dst.digits >= src.digits;
+}
+
+Value widenNumber(NumberRef value, NumberKind to)
+{
+    switch (to)
+    {
+
+#define reflectWidenNumber(kind, T)                                     \
+    case NumberKind::kind: return Value(loadNumber<T>(value));
+
+    reflectNumberKinds(reflectWidenNumber)
+
+#undef reflectWidenNumber
+
+    default: reflectError("widening to an unknown number kind");
+    }
+}
+
+#undef reflectNumberKinds
+
+} // reflect
@@ -0,0 +1,117 @@
+/* number.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Kind tags for the primitive number types which allow Values to do
+   arithmetic without going through overload resolution.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* NUMBER KIND                                                                */
+/******************************************************************************/
+
+enum struct NumberKind : uint8_t
+{
+    None,
+    Bool,
+    Char, SChar, UChar,
+    Short, UShort,
+    Int, UInt,
+    Long, ULong,
+    LongLong, ULongLong,
+    Float, Double, LongDouble,
+};
+
+std::ostream& operator<<(std::ostream& stream, NumberKind kind);
+
+template<typename T>
+struct NumberKindOf
+{
+    static constexpr NumberKind value = NumberKind::None;
+};
+
+#define reflectNumberKindOf(T, kind)                            \
+    template<>                                                  \
+    struct NumberKindOf<T>                                      \
+    {                                                           \
+        static constexpr NumberKind value = NumberKind::kind;   \
+    };
+
+reflectNumberKindOf(bool, Bool)
+reflectNumberKindOf(char, Char)
+reflectNumberKindOf(signed char, SChar)
+reflectNumberKindOf(unsigned char, UChar)
+reflectNumberKindOf(short int, Short)
+reflectNumberKindOf(unsigned short int, UShort)
+reflectNumberKindOf(int, Int)
+reflectNumberKindOf(unsigned int, UInt)
+reflectNumberKindOf(long int, Long)
+reflectNumberKindOf(unsigned long int, ULong)
+reflectNumberKindOf(long long int, LongLong)
+reflectNumberKindOf(unsigned long long int, ULongLong)
+reflectNumberKindOf(float, Float)
+reflectNumberKindOf(double, Double)
+reflectNumberKindOf(long double, LongDouble)
+
+#undef reflectNumberKindOf
+
+template<typename T>
+constexpr NumberKind numberKind()
+{
+    return NumberKindOf<typename std::decay<T>::type>::value;
+}
+
+
+/******************************************************************************/
+/* NUMBER REF                                                                 */
+/******************************************************************************/
+
+// Kind-tagged pointer to a number; kind is None for anything else.
+struct NumberRef
+{
+    NumberKind kind;
+    const void* value;
+};
+
+template<typename T>
+NumberRef numberRef(const T& value)
+{
+    return { numberKind<T>(), &value };
+}
+
+inline NumberRef numberRef(const Value& value);
+
+
+/******************************************************************************/
+/* NUMBER OPS                                                                 */
+/******************************************************************************/
+
+enum struct NumberOp : uint8_t
+{
+    Add, Sub, Mul, Div, Mod,
+    And, Or, Xor,
+    Eq, Ne, Lt, Gt, Le, Ge,
+};
+
+/** Applies op to the two numbers following the usual C++ arithmetic
+    conversions and stores the result in out. Returns false if either isn't a
+    number or if the op isn't defined for the types (eg. % on floats).
+ */
+bool numberOp(NumberOp op, NumberRef lhs, NumberRef rhs, Value& out);
+
+// Equivalent to a static_cast into the number of the given kind at out.
+bool numberConvert(NumberRef value, NumberKind kind, void* out);
+
+// value must be a number.
+bool numberToBool(NumberRef value);
+
+// Conversions that never lose information (eg. int to int64_t or double).
+bool isWideningNumber(NumberKind from, NumberKind to);
+Value widenNumber(NumberRef value, NumberKind to);
+
+} // reflect
@@ -9,15 +9,185 @@
 
 namespace reflect {
 
+namespace {
+
+// Types are at least 8 bytes aligned which leaves room in the low bits of
+// their address for the ref type and constness.
+uint64_t packArgument(const Argument& arg)
+{
+    return uint64_t(uintptr_t(arg.type()))
+        | (uint64_t(arg.refType()) << 1)
+        | uint64_t(arg.isConst());
+}
+
+uint64_t signatureHash(const Argument* args, size_t size)
+{
+    uint64_t hash = size;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= packArgument(args[i]);
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+    }
+
+    return hash;
+}
+
+const std::vector<size_t> emptyBucket;
+
+// Threads are spread round-robin over the shards of the call cache counters.
+size_t callCacheShard(size_t shards)
+{
+    static std::atomic<size_t> nextThread(0);
+    static thread_local size_t thread =
+        nextThread.fetch_add(1, std::memory_order_relaxed);
+    return thread % shards;
+}
+
+} // namespace anonymous
+
+
+/******************************************************************************/
+/* CALL CACHE                                                                 */
+/******************************************************************************/
+
+Overloads::CallCache::
+CallCache() : next(0)
+{
+    for (auto& slot : slots) {
+        slot.version.store(0, std::memory_order_relaxed);
+        slot.size.store(0, std::memory_order_relaxed);
+        slot.fn.store(nullptr, std::memory_order_relaxed);
+        for (auto& key : slot.key) key.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& shard : counters) {
+        shard.hits.store(0, std::memory_order_relaxed);
+        shard.misses.store(0, std::memory_order_relaxed);
+    }
+}
+
+const Function*
+Overloads::CallCache::
+find(const Argument* key, size_t size) const
+{
+    Counters& shard = counters[callCacheShard(Shards)];
+
+    if (size > MaxKey) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    uint64_t packed[MaxKey];
+    for (size_t i = 0; i < size; ++i) packed[i] = packArgument(key[i]);
+
+    for (const auto& slot : slots) {
+        size_t version = slot.version.load(std::memory_order_acquire);
+        if (version & 1) continue;
+        if (slot.size.load(std::memory_order_relaxed) != size) continue;
+
+        bool match = true;
+        for (size_t i = 0; match && i < size; ++i)
+            match = slot.key[i].load(std::memory_order_relaxed) == packed[i];
+
+        const Function* fn = slot.fn.load(std::memory_order_relaxed);
+
+        // Anything read while a writer was busy with the slot is discarded.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != version) continue;
+        if (!match) continue;
+
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        return fn;
+    }
+
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+/** The result of overload resolution depends on the hierarchy and the
+    converters of the types involved which can still change while they're
+    being loaded so those calls are never cached.
+ */
+void
+Overloads::CallCache::
+insert(const Argument* key, size_t size, const Function* fn)
+{
+    if (size > MaxKey) return;
+
+    if (!Registry::isLoaded(fn->returnType().type())) return;
+    for (size_t i = 0; i < size; ++i) {
+        if (!Registry::isLoaded(key[i].type())) return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    write(slots[next++ % Ways], key, size, fn);
+}
+
+void
+Overloads::CallCache::
+clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto& slot : slots) write(slot, nullptr, 0, nullptr);
+}
+
+// Must be called while holding the lock.
+void
+Overloads::CallCache::
+write(Slot& slot, const Argument* key, size_t size, const Function* fn)
+{
+    size_t version = slot.version.load(std::memory_order_relaxed);
+    slot.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.size.store(size, std::memory_order_relaxed);
+    slot.fn.store(fn, std::memory_order_relaxed);
+    for (size_t i = 0; i < size; ++i)
+        slot.key[i].store(packArgument(key[i]), std::memory_order_relaxed);
+
+    slot.version.store(version + 2, std::memory_order_release);
+}
+
+size_t
+Overloads::CallCache::
+hits() const
+{
+    size_t total = 0;
+    for (const auto& shard : counters)
+        total += shard.hits.load(std::memory_order_relaxed);
+    return total;
+}
+
+size_t
+Overloads::CallCache::
+misses() const
+{
+    size_t total = 0;
+    for (const auto& shard : counters)
+        total += shard.misses.load(std::memory_order_relaxed);
+    return total;
+}
+
+
 /******************************************************************************/
 /* OVERLOADS                                                                  */
 /******************************************************************************/
 
+Overloads::
+Overloads() : cache(new CallCache) {}
+
 void
 Overloads::
 add(Function fn)
 {
-    for (const auto& other : overloads) {
+    if (Registry::isSealed())
+        reflectError("can't add overload <%s> to a sealed registry", fn.name());
+
+    // Overloads of different arities can never be ambiguous.
+    size_t arity = fn.arguments();
+    for (size_t i : bucket(arity)) {
+        const Function& other = overloads[i];
         if (fn.test(other) != Match::Exact) continue;
 
         reflectError("<%s, %s> is ambiguous with <%s, %s>",
@@ -25,15 +195,28 @@ add(Function fn)
                 other.name(), signature(other));
     }
 
+    if (arities.size() <= arity) arities.resize(arity + 1);
+    arities[arity].push_back(overloads.size());
+    exact[signatureHash(fn.args.data(), arity)].push_back(overloads.size());
+
+    // Growing the vector moves the functions which invalidates the cache.
     overloads.emplace_back(std::move(fn));
+    cache->clear();
+}
+
+const std::vector<size_t>&
+Overloads::
+bucket(size_t arity) const
+{
+    return arity < arities.size() ? arities[arity] : emptyBucket;
 }
 
 bool
 Overloads::
 test(const Function& fn) const
 {
-    for (const auto& other : overloads) {
-        if (fn.test(other) != Match::None) return true;
+    for (size_t i : bucket(fn.arguments())) {
+        if (fn.test(overloads[i]) != Match::None) return true;
     }
     return false;
 }
@@ -42,8 +225,8 @@ bool
 Overloads::
 test(const Argument& ret, const std::vector<Argument>& args) const
 {
-    for (const auto& fn : overloads) {
-        if (fn.test(ret, args) != Match::None) return true;
+    for (size_t i : bucket(args.size())) {
+        if (overloads[i].test(ret, args) != Match::None) return true;
     }
     return false;
 }
@@ -52,19 +235,121 @@ const Function&
 Overloads::
 get(const Argument& ret, const std::vector<Argument>& args) const
 {
-    for (const auto& fn : overloads) {
-        if (fn.test(ret, args) != Match::None) return fn;
+    for (size_t i : bucket(args.size())) {
+        if (overloads[i].test(ret, args) != Match::None) return overloads[i];
     }
 
     reflectError("no overload <%s> available for function <%s>",
             signature(ret, args), name());
 }
 
-std::string
+const Function&
+Overloads::
+resolve(const Argument* key, size_t size) const
+{
+    StatusCode code;
+    if (const Function* fn = tryResolve(key, size, code)) return *fn;
+
+    const Argument& ret = key[0];
+    const Argument* args = key + 1;
+    size_t arity = size - 1;
+
+    if (code == StatusCode::Ambiguous) {
+        reflectError("ambiguous function call <%s> for function <%s>",
+                signature(ret, { args, args + arity }), name());
+    }
+
+    reflectError("no overload <%s> available for function <%s>",
+            signature(ret, { args, args + arity }), name());
+}
+
+const Function*
+Overloads::
+tryResolve(const Argument* key, size_t size, StatusCode& code) const
+{
+    const Argument& ret = key[0];
+    const Argument* args = key + 1;
+    size_t arity = size - 1;
+
+    code = StatusCode::Ok;
+    if (const Function* fn = findExact(ret, args, arity)) return fn;
+
+    const Function* bestFn = nullptr;
+    bool ambiguous = false;
+
+    for (size_t i : bucket(arity)) {
+        const Function& fn = overloads[i];
+
+        Match match = fn.test(ret, args, arity);
+        if (match == Match::None) continue;
+
+        if (bestFn && match == Match::Partial) {
+            ambiguous = true;
+            continue;
+        }
+
+        bestFn = &fn;
+
+        if (match == Match::Exact) {
+            ambiguous = false;
+            break;
+        }
+    }
+
+    if (!bestFn) {
+        code = StatusCode::NoOverload;
+        return nullptr;
+    }
+
+    if (ambiguous) {
+        code = StatusCode::Ambiguous;
+        return nullptr;
+    }
+
+    return bestFn;
+}
+
+/** Finds an overload whose argument list is identical to the call's. The
+    return value only needs to be compatible since testReturn() never yields
+    partial matches.
+ */
+const Function*
+Overloads::
+findExact(const Argument& ret, const Argument* args, size_t arity) const
+{
+    auto it = exact.find(signatureHash(args, arity));
+    if (it == exact.end()) return nullptr;
+
+    for (size_t i : it->second) {
+        const Function& fn = overloads[i];
+        if (!std::equal(args, args + arity, fn.args.begin())) continue;
+        if (fn.testReturn(ret, fn.ret) == Match::None) continue;
+        return &fn;
+    }
+
+    return nullptr;
+}
+
+size_t
+Overloads::
+cacheHits() const
+{
+    return cache->hits();
+}
+
+size_t
+Overloads::
+cacheMisses() const
+{
+    return cache->misses();
+}
+
+const std::string&
 Overloads::
 name() const
 {
-    if (overloads.empty()) return "?";
+    static const std::string unknown = "?";
+    if (overloads.empty()) return unknown;
     return overloads.front().name();
 }
 
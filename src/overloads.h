@@ -16,8 +16,10 @@ namespace reflect {
 
 struct Overloads : public Traits
 {
+    Overloads();
+
     // For debugging purposes only.
-    std::string name() const;
+    const std::string& name() const;
 
     size_t size() const { return overloads.size(); }
     Function& operator[] (size_t i) { return overloads[i]; }
@@ -37,10 +39,116 @@ struct Overloads : public Traits
     template<typename Ret, typename... Args>
     Ret call(Args&&... args) const;
 
+    /** Calls the function once per element of out and stores the results in
+        out. Each argument is either a Span with at least out.size() elements,
+        whose i-th element is used for the i-th call, or a scalar which is
+        passed as an l-value to every call. Overload resolution is only redone
+        when the shape of the arguments changes from one call to the next which
+        can only happen for Values. Without Values, an overload whose native
+        signature takes each element as is, as a const reference or, for
+        trivially copyable types, by value is called directly.
+     */
+    template<typename Ret, typename... Args>
+    void callBatch(Span<Ret> out, Args&&... args) const;
+
+    // Assigns the result to out without boxing it in a Value when the
+    // selected overload returns exactly Ret. See Function::callInto.
+    template<typename Ret, typename... Args>
+    void callInto(Ret& out, Args&&... args) const;
+
+    /** Non-throwing version of callInto which reports overload resolution
+        failures through the returned status. Errors raised by the function
+        itself or by the casting of its arguments are still reported through
+        reflectError.
+     */
+    template<typename Ret, typename... Args>
+    Status tryCall(Ret& out, Args&&... args) const;
+
+    /** Constructs the result of the overload returning ret in the
+        uninitialized memory pointed to by slot. The selected overload must
+        return exactly ret's type so that the object fits in the slot. See
+        Function::constructInto.
+     */
+    template<typename... Args>
+    void constructInto(void* slot, const Argument& ret, Args&&... args) const;
+
+    // Prefers the overload whose native signature is exactly Fn.
+    template<typename Fn>
+    Invoker<Fn> bind() const;
+
+    // Number of calls that were dispatched through the call cache or that had
+    // to go through overload resolution.
+    size_t cacheHits() const;
+    size_t cacheMisses() const;
+
     std::string print(size_t indent = 0) const;
 
 private:
+
+    /** Remembers which overload won for the last few argument shapes (return
+        type followed by the argument types) seen by call(). Slots are
+        overwritten in place under a seqlock so readers never block and the
+        cache never holds more than Ways shapes. Shapes with more than MaxKey
+        arguments aren't cached.
+
+        Hits and misses are spread over a few shards picked per thread so
+        that callers on different threads rarely touch the same counter.
+     */
+    struct CallCache
+    {
+        enum { Ways = 4, MaxKey = 8, Shards = 8 };
+
+        struct Slot
+        {
+            std::atomic<size_t> version;
+            std::atomic<size_t> size;
+            std::atomic<const Function*> fn;
+            std::atomic<uint64_t> key[MaxKey];
+        };
+
+        struct Counters
+        {
+            std::atomic<size_t> hits;
+            std::atomic<size_t> misses;
+            uint8_t pad[64 - 2 * sizeof(std::atomic<size_t>)];
+        };
+
+        CallCache();
+
+        const Function* find(const Argument* key, size_t size) const;
+        void insert(const Argument* key, size_t size, const Function* fn);
+        void clear();
+
+        size_t hits() const;
+        size_t misses() const;
+
+        Slot slots[Ways];
+        size_t next;
+
+        mutable Counters counters[Shards];
+
+        std::mutex lock;
+
+    private:
+        void write(Slot& slot, const Argument* key, size_t size,
+                const Function* fn);
+    };
+
+    const Function& resolve(const Argument* key, size_t size) const;
+    const Function* tryResolve(
+            const Argument* key, size_t size, StatusCode& code) const;
+    const Function* findExact(
+            const Argument& ret, const Argument* args, size_t arity) const;
+    const std::vector<size_t>& bucket(size_t arity) const;
+
     std::vector<Function> overloads;
+
+    // Indexes into overloads bucketed by arity along with a hash of the packed
+    // argument lists so that exact matches don't require a scan.
+    std::vector< std::vector<size_t> > arities;
+    std::unordered_map< uint64_t, std::vector<size_t> > exact;
+
+    std::unique_ptr<CallCache> cache;
 };
 
 } // reflect
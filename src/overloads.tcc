@@ -10,6 +10,152 @@
 
 namespace reflect {
 
+/******************************************************************************/
+/* BATCH                                                                      */
+/******************************************************************************/
+
+namespace details {
+
+template<typename T>
+T& batchArg(Span<T>& arg, size_t i) { return arg[i]; }
+
+template<typename T>
+T& batchArg(const Span<T>& arg, size_t i) { return arg[i]; }
+
+template<typename T>
+T& batchArg(T& arg, size_t) { return arg; }
+
+
+template<typename T>
+size_t batchSize(const Span<T>& arg) { return arg.size(); }
+
+template<typename T>
+size_t batchSize(const T&) { return size_t(-1); }
+
+
+// Type of the argument passed to each call of the batch.
+template<typename Arg>
+struct BatchArg
+{
+    typedef typename std::remove_reference<Arg>::type& ArgRef;
+    typedef decltype(batchArg(std::declval<ArgRef>(), size_t(0))) type;
+};
+
+// Values and ValueRefs are the only arguments whose type can change from one
+// element of the batch to the next.
+template<typename... Args>
+struct IsBatchStatic : public std::true_type {};
+
+template<typename Arg, typename... Rest>
+struct IsBatchStatic<Arg, Rest...>
+{
+    typedef typename std::decay<typename BatchArg<Arg>::type>::type CleanArg;
+
+    static constexpr bool value =
+        !std::is_same<CleanArg, Value>::value &&
+        !std::is_same<CleanArg, ValueRef>::value &&
+        IsBatchStatic<Rest...>::value;
+
+    typedef std::integral_constant<bool, value> type;
+};
+
+
+/** Builds the native signature of a batch one parameter at a time by looking
+    at how the function takes each of its arguments. An element of the batch
+    can be passed as is, as a const reference or, if it's trivially copyable,
+    by value. Returns false if the resulting signature isn't the function's
+    native signature.
+
+    Every variant is instantiated so this is kept to at most 3 per argument.
+ */
+template<typename Ret, typename Params, typename Rest> struct BatchNative;
+
+template<typename Ret, typename... Params>
+struct BatchNative< Ret, TypeVector<Params...>, TypeVector<> >
+{
+    template<typename... Args>
+    static bool call(const Function& fn, size_t, Span<Ret> out, Args&... args)
+    {
+        typedef Ret Native(Params...);
+        if (!fn.isNative<Native>()) return false;
+
+        Invoker<Native> invoker(fn);
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = invoker(batchArg(args, i)...);
+
+        return true;
+    }
+};
+
+template<typename Ret, typename... Params, typename Arg, typename... Rest>
+struct BatchNative< Ret, TypeVector<Params...>, TypeVector<Arg, Rest...> >
+{
+    typedef typename BatchArg<Arg>::type Element;
+    typedef typename std::decay<Element>::type CleanT;
+
+    template<typename Param>
+    struct Next
+    {
+        typedef TypeVector<Params..., Param> NextParams;
+        typedef BatchNative<Ret, NextParams, TypeVector<Rest...> > type;
+    };
+
+    template<typename... Args>
+    static bool call(
+            const Function& fn, size_t index, Span<Ret> out, Args&... args)
+    {
+        const Argument& param = fn.argument(index);
+
+        if (param.refType() == RefType::Copy) {
+            typedef typename std::is_trivially_copyable<CleanT>::type IsTrivial;
+            return byValue(IsTrivial(), fn, index, out, args...);
+        }
+
+        if (param.refType() != RefType::LValue) return false;
+
+        if (param.isConst()) {
+            typedef typename Next<const CleanT&>::type Const;
+            return Const::call(fn, index + 1, out, args...);
+        }
+
+        typedef typename Next<Element>::type AsIs;
+        return AsIs::call(fn, index + 1, out, args...);
+    }
+
+    template<typename... Args>
+    static bool byValue(
+            std::true_type,
+            const Function& fn, size_t index, Span<Ret> out, Args&... args)
+    {
+        typedef typename Next<CleanT>::type Copy;
+        return Copy::call(fn, index + 1, out, args...);
+    }
+
+    template<typename... Args>
+    static bool byValue(
+            std::false_type, const Function&, size_t, Span<Ret>, Args&...)
+    {
+        return false;
+    }
+};
+
+template<typename Ret, typename... Args>
+bool batchNative(
+        std::true_type, const Function& fn, Span<Ret> out, Args&... args)
+{
+    typedef BatchNative< Ret, TypeVector<>, TypeVector<Args...> > Native;
+    return Native::call(fn, 0, out, args...);
+}
+
+template<typename Ret, typename... Args>
+bool batchNative(std::false_type, const Function&, Span<Ret>, Args&...)
+{
+    return false;
+}
+
+} // namespace details
+
+
 /******************************************************************************/
 /* OVERLOADS                                                                  */
 /******************************************************************************/
@@ -19,11 +165,10 @@ bool
 Overloads::
 test() const
 {
-    for (const auto& fn : overloads) {
-        if (fn.test<Fn>() != Match::None) return true;
+    for (size_t i : bucket(FunctionType<Fn>::ArgCount)) {
+        if (overloads[i].test<Fn>() != Match::None) return true;
     }
     return false;
-
 }
 
 template<typename Fn>
@@ -31,57 +176,174 @@ const Function&
 Overloads::
 get() const
 {
-    for (const auto& fn : overloads) {
-        if (fn.test<Fn>() != Match::None) return fn;
+    for (size_t i : bucket(FunctionType<Fn>::ArgCount)) {
+        if (overloads[i].test<Fn>() != Match::None) return overloads[i];
     }
 
     reflectError("no overload <%s> available for function <%s>",
             signature<Fn>(), name());
 }
 
+template<typename Fn>
+Invoker<Fn>
+Overloads::
+bind() const
+{
+    for (size_t i : bucket(FunctionType<Fn>::ArgCount)) {
+        if (overloads[i].isNative<Fn>()) return overloads[i].bind<Fn>();
+    }
+
+    return get<Fn>().template bind<Fn>();
+}
+
 template<typename Ret, typename... Args>
 Ret
 Overloads::
 call(Args&&... args) const
 {
-    const Function* bestFn = nullptr;
-    bool ambiguous = false;
+    enum { Size = sizeof...(Args) + 1 };
+
+    Argument key[Size];
+    key[0] = Argument::make<Ret>();
+    reflectArguments(key + 1, std::forward<Args>(args)...);
 
-    for (const auto& fn : overloads) {
+    const Function* fn = cache->find(key, Size);
+    if (!fn) {
+        fn = &resolve(key, Size);
+        cache->insert(key, Size, fn);
+    }
 
-        Match match = fn.testParams<Ret>(std::forward<Args>(args)...);
-        if (match == Match::None) continue;
+    return fn->invoke<Ret>(std::forward<Args>(args)...);
+}
 
-        if (bestFn && match == Match::Partial) {
-            ambiguous = true;
-            continue;
-        }
+template<typename Ret, typename... Args>
+void
+Overloads::
+callInto(Ret& out, Args&&... args) const
+{
+    enum { Size = sizeof...(Args) + 1 };
 
-        bestFn = &fn;
+    Argument key[Size];
+    key[0] = Argument::make<Ret>();
+    reflectArguments(key + 1, std::forward<Args>(args)...);
 
-        if (match == Match::Exact) {
-            ambiguous = false;
-            break;
-        }
+    const Function* fn = cache->find(key, Size);
+    if (!fn) {
+        fn = &resolve(key, Size);
+        cache->insert(key, Size, fn);
     }
 
-    if (!bestFn) {
-        reflectError("no overload <%s> available for function <%s>",
-                signature(
-                        Argument::make<Ret>(),
-                        reflectArguments(std::forward<Args>(args)...)),
-                name());
+    if (fn->isReturnSlot<Ret>())
+        fn->invokeInto(out, std::forward<Args>(args)...);
+    else out = fn->invoke<Ret>(std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+void
+Overloads::
+constructInto(void* slot, const Argument& ret, Args&&... args) const
+{
+    enum { Size = sizeof...(Args) + 1 };
+
+    Argument key[Size];
+    key[0] = ret;
+    reflectArguments(key + 1, std::forward<Args>(args)...);
+
+    const Function* fn = cache->find(key, Size);
+    if (!fn) {
+        fn = &resolve(key, Size);
+        cache->insert(key, Size, fn);
     }
 
-    if (ambiguous) {
-        reflectError("ambiguous function call <%s> for function <%s>",
-                signature(
-                        Argument::make<Ret>(),
-                        reflectArguments(std::forward<Args>(args)...)),
+    if (fn->returnType().type() != ret.type()) {
+        reflectError("<%s> can't be constructed in place of <%s>",
+                fn->returnType().type()->id(), ret.type()->id());
+    }
+
+    fn->invokeConstructInto(slot, std::forward<Args>(args)...);
+}
+
+template<typename Ret, typename... Args>
+Status
+Overloads::
+tryCall(Ret& out, Args&&... args) const
+{
+    enum { Size = sizeof...(Args) + 1 };
+
+    Argument key[Size];
+    key[0] = Argument::make<Ret>();
+    reflectArguments(key + 1, std::forward<Args>(args)...);
+
+    const Function* fn = cache->find(key, Size);
+    if (!fn) {
+        StatusCode code;
+        fn = tryResolve(key, Size, code);
+        if (!fn) return Status(code, this);
+
+        cache->insert(key, Size, fn);
+    }
+
+    if (fn->isReturnSlot<Ret>())
+        fn->invokeInto(out, std::forward<Args>(args)...);
+    else out = fn->invoke<Ret>(std::forward<Args>(args)...);
+
+    return Status();
+}
+
+template<typename Ret, typename... Args>
+void
+Overloads::
+callBatch(Span<Ret> out, Args&&... args) const
+{
+    enum { Size = sizeof...(Args) + 1 };
+
+    size_t size = std::min({ out.size(), details::batchSize(args)... });
+    if (size < out.size()) {
+        reflectError("batch arguments are smaller than the output for <%s>",
                 name());
     }
 
-    return bestFn->call<Ret>(std::forward<Args>(args)...);
+    if (out.empty()) return;
+
+    Argument key[Size];
+    key[0] = Argument::make<Ret>();
+    reflectArguments(key + 1, details::batchArg(args, 0)...);
+
+    const Function* fn = cache->find(key, Size);
+    if (!fn) {
+        fn = &resolve(key, Size);
+        cache->insert(key, Size, fn);
+    }
+
+    // Without Values, every element has the same shape so the overload is
+    // only resolved once and native matches skip the boxing altogether.
+    typedef typename details::IsBatchStatic<Args...>::type IsStatic;
+    if (IsStatic::value) {
+        if (details::batchNative(IsStatic(), *fn, out, args...)) return;
+
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = fn->invoke<Ret>(details::batchArg(args, i)...);
+
+        return;
+    }
+
+    Argument last[Size];
+    std::copy(key, key + Size, last);
+
+    for (size_t i = 0; i < out.size(); ++i) {
+        if (i) reflectArguments(key + 1, details::batchArg(args, i)...);
+
+        if (!std::equal(key + 1, key + Size, last + 1)) {
+            fn = cache->find(key, Size);
+            if (!fn) {
+                fn = &resolve(key, Size);
+                cache->insert(key, Size, fn);
+            }
+            std::copy(key, key + Size, last);
+        }
+
+        out[i] = fn->invoke<Ret>(details::batchArg(args, i)...);
+    }
 }
 
 } // reflect
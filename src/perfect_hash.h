@@ -0,0 +1,62 @@
+/* perfect_hash.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Immutable string keyed perfect hash table.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* PERFECT HASH                                                               */
+/******************************************************************************/
+
+/** Read-only map built once from a fixed set of keys using the
+    hash-and-displace method: keys are first split into small buckets and
+    each bucket is then assigned a seed which scatters its keys into free
+    slots of a flat array.
+
+    A lookup hashes the key once and then reads one displacement and one
+    entry which means that it touches at most two cache lines regardless of
+    the size of the table.
+ */
+template<typename T>
+struct PerfectHash
+{
+    PerfectHash() {}
+    explicit PerfectHash(std::vector< std::pair<std::string, T> > items);
+
+    size_t size() const { return size_; }
+    bool empty() const { return !size_; }
+
+    const T* find(const std::string& key) const;
+
+    template<typename Fn>
+    void forEach(const Fn& fn) const;
+
+private:
+
+    struct Entry
+    {
+        Entry() : hash(0), used(false) {}
+
+        uint64_t hash;
+        bool used;
+        std::string key;
+        T value;
+    };
+
+    static uint64_t hash(const std::string& key);
+    static size_t slot(uint64_t hash, uint32_t seed, size_t size);
+
+    bool build(std::vector< std::pair<std::string, T> >& items, size_t slots);
+
+    size_t size_ = 0;
+    std::vector<uint32_t> seeds;
+    std::vector<Entry> entries;
+};
+
+} // reflect
@@ -0,0 +1,143 @@
+/* perfect_hash.tcc                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Template implementation of PerfectHash.
+*/
+
+#include "reflect.h"
+#pragma once
+
+#include <algorithm>
+
+namespace reflect {
+
+/******************************************************************************/
+/* PERFECT HASH                                                               */
+/******************************************************************************/
+
+template<typename T>
+PerfectHash<T>::
+PerfectHash(std::vector< std::pair<std::string, T> > items) :
+    size_(items.size())
+{
+    if (items.empty()) return;
+
+    // Each failed attempt gives us a bit more breathing room which keeps the
+    // seed search short for awkward key sets.
+    size_t slots = items.size() + items.size() / 4 + 1;
+    while (!build(items, slots)) slots += slots / 4 + 1;
+}
+
+template<typename T>
+uint64_t
+PerfectHash<T>::
+hash(const std::string& key)
+{
+    return std::hash<std::string>()(key);
+}
+
+template<typename T>
+size_t
+PerfectHash<T>::
+slot(uint64_t hash, uint32_t seed, size_t size)
+{
+    // Finalizer from murmur3 to spread the seed over all the bits.
+    uint64_t h = hash ^ (seed * 0x9E3779B97F4A7C15ULL);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h % size;
+}
+
+template<typename T>
+bool
+PerfectHash<T>::
+build(std::vector< std::pair<std::string, T> >& items, size_t slots)
+{
+    enum { MaxSeed = 1 << 16 };
+
+    size_t buckets = (items.size() + 3) / 4;
+
+    std::vector< std::vector<size_t> > keys(buckets);
+    std::vector<uint64_t> hashes(items.size());
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        hashes[i] = hash(items[i].first);
+        keys[(hashes[i] >> 32) % buckets].push_back(i);
+    }
+
+    std::vector<size_t> order(buckets);
+    for (size_t i = 0; i < buckets; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&] (size_t lhs, size_t rhs) {
+                return keys[lhs].size() > keys[rhs].size();
+            });
+
+    seeds.assign(buckets, 0);
+    entries.assign(slots, Entry());
+
+    std::vector<size_t> taken;
+
+    for (size_t bucket : order) {
+        const auto& bucketKeys = keys[bucket];
+        if (bucketKeys.empty()) break;
+
+        uint32_t seed = 0;
+        for (; seed < MaxSeed; ++seed) {
+            taken.clear();
+
+            for (size_t key : bucketKeys) {
+                size_t i = slot(hashes[key], seed, slots);
+                if (entries[i].used) break;
+                if (std::find(taken.begin(), taken.end(), i) != taken.end()) break;
+                taken.push_back(i);
+            }
+
+            if (taken.size() == bucketKeys.size()) break;
+        }
+        if (seed == MaxSeed) return false;
+
+        seeds[bucket] = seed;
+
+        for (size_t j = 0; j < bucketKeys.size(); ++j) {
+            size_t key = bucketKeys[j];
+
+            Entry& entry = entries[taken[j]];
+            entry.hash = hashes[key];
+            entry.used = true;
+            entry.key = items[key].first;
+            entry.value = items[key].second;
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+const T*
+PerfectHash<T>::
+find(const std::string& key) const
+{
+    if (!size_) return nullptr;
+
+    uint64_t h = hash(key);
+    uint32_t seed = seeds[(h >> 32) % seeds.size()];
+
+    const Entry& entry = entries[slot(h, seed, entries.size())];
+    if (!entry.used || entry.hash != h || entry.key != key) return nullptr;
+
+    return &entry.value;
+}
+
+template<typename T>
+template<typename Fn>
+void
+PerfectHash<T>::
+forEach(const Fn& fn) const
+{
+    for (const auto& entry : entries) {
+        if (entry.used) fn(entry.key, entry.value);
+    }
+}
+
+} // reflect
@@ -11,10 +11,15 @@
 #include "ref_type.cpp"
 
 #include "registry.cpp"
+#include "arena.cpp"
+#include "value_arena.cpp"
 #include "argument.cpp"
+#include "status.cpp"
+#include "number.cpp"
 #include "cast.cpp"
 #include "traits.cpp"
 #include "value.cpp"
+#include "value_ref.cpp"
 #include "value_function.cpp"
 #include "scope.cpp"
 #include "type.cpp"
@@ -15,14 +15,19 @@
 #pragma once
 
 #include <string>
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <type_traits>
 #include <vector>
+#include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
 #include <cstddef>
+#include <cstdint>
 
 #include <iostream> // used only in print functions.
 
@@ -38,32 +43,50 @@ namespace reflect {
 struct Type;
 struct Scope;
 struct Value;
+struct ValueRef;
 struct Field;
 struct Function;
 struct Overloads;
+struct Argument;
+struct Arena;
+
+typedef size_t TraitKey;
 
 } // namespace reflect
 
+#include "perfect_hash.h"
+#include "span.h"
 #include "registry.h"
 #include "argument.h"
+#include "status.h"
+#include "number.h"
+#include "arena.h"
+#include "value_arena.h"
 #include "value.h"
+#include "value_ref.h"
 #include "traits.h"
 #include "cast.h"
 #include "value_function.h"
 #include "field.h"
 #include "function.h"
+#include "invoker.h"
 #include "overloads.h"
 #include "type.h"
 #include "scope.h"
+#include "field_handle.h"
 
+#include "perfect_hash.tcc"
 #include "traits.tcc"
 #include "argument.tcc"
 #include "value.tcc"
+#include "value_ref.tcc"
 #include "field.tcc"
 #include "function.tcc"
+#include "invoker.tcc"
 #include "overloads.tcc"
 #include "type.tcc"
 #include "scope.tcc"
+#include "field_handle.tcc"
 
 #include "dsl/type.h"
 
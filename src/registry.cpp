@@ -8,30 +8,469 @@
 #include "reflect.h"
 
 #include <mutex>
+#include <thread>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <condition_variable>
 
 namespace reflect {
 
+namespace {
+
 /******************************************************************************/
-/* REGISTRY STATE                                                             */
+/* NAME TABLE                                                                 */
 /******************************************************************************/
 
-namespace {
+/** Insert-only open-addressing hash table which maps ids and aliases to fully
+    loaded types. Readers never lock: entries are immutable once published and
+    slots only ever go from null to non-null. Inserts happen under the registry
+    lock and, when the table runs out of room, a bigger copy is published in
+    its place. Old tables are kept around until the registry dies since
+    readers may still be walking them.
+ */
+struct NameTable
+{
+    struct Entry
+    {
+        Entry(size_t hash, std::string name, const Type* type) :
+            hash(hash), name(std::move(name)), type(type)
+        {}
+
+        const size_t hash;
+        const std::string name;
+        const Type* const type;
+    };
+
+    explicit NameTable(size_t capacity) :
+        mask(capacity - 1), size(0),
+        slots(new std::atomic<const Entry*>[capacity])
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+    bool full() const { return (size + 1) * 2 > capacity(); }
+
+    const Type* find(const std::string& name) const
+    {
+        return find(std::hash<std::string>()(name), name);
+    }
+
+    const Type* find(size_t hash, const std::string& name) const
+    {
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Entry* entry = slots[i].load(std::memory_order_acquire);
+            if (!entry) return nullptr;
+            if (entry->hash == hash && entry->name == name) return entry->type;
+        }
+    }
+
+    // Must be called while holding the registry lock.
+    void insert(const Entry* entry)
+    {
+        for (size_t i = entry->hash & mask;; i = (i + 1) & mask) {
+            if (slots[i].load(std::memory_order_relaxed)) continue;
+
+            slots[i].store(entry, std::memory_order_release);
+            size++;
+            return;
+        }
+    }
+
+    const size_t mask;
+    size_t size;
+    std::unique_ptr<std::atomic<const Entry*>[]> slots;
+};
+
+
+/******************************************************************************/
+/* INDEX TABLE                                                                */
+/******************************************************************************/
+
+/** Maps type indexes to fully loaded types using a fixed two-level array so
+    that the table never has to move when it grows and can therefore be read
+    without locks. Chunks are only allocated while holding the registry lock.
+ */
+struct IndexTable
+{
+    enum
+    {
+        ChunkBits = 10,
+        ChunkSize = 1 << ChunkBits,
+        ChunkMask = ChunkSize - 1,
+        Chunks = 1 << 12,
+    };
+
+    typedef std::atomic<const Type*> Slot;
+
+    IndexTable()
+    {
+        for (auto& chunk : chunks) chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~IndexTable()
+    {
+        for (auto& chunk : chunks) delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    const Type* find(TypeIndex index) const
+    {
+        if ((index >> ChunkBits) >= Chunks) return nullptr;
+
+        Slot* chunk = chunks[index >> ChunkBits].load(std::memory_order_acquire);
+        if (!chunk) return nullptr;
+
+        return chunk[index & ChunkMask].load(std::memory_order_acquire);
+    }
+
+    // Must be called while holding the registry lock.
+    void insert(TypeIndex index, const Type* type)
+    {
+        if ((index >> ChunkBits) >= Chunks)
+            reflectError("too many types to index <%s>", type->id());
+
+        auto& chunkSlot = chunks[index >> ChunkBits];
+
+        Slot* chunk = chunkSlot.load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = new Slot[ChunkSize];
+            for (size_t i = 0; i < ChunkSize; ++i)
+                chunk[i].store(nullptr, std::memory_order_relaxed);
+            chunkSlot.store(chunk, std::memory_order_release);
+        }
+
+        chunk[index & ChunkMask].store(type, std::memory_order_release);
+    }
+
+private:
+    std::atomic<Slot*> chunks[Chunks];
+};
+
+
+/******************************************************************************/
+/* REGISTRY STATE                                                             */
+/******************************************************************************/
 
 struct RegistryState
 {
+    struct Loading
+    {
+        Type* type;
+        std::thread::id owner;
+        bool finished;
+        bool failed;
+    };
+
+    // Loads in progress on a thread. Types are only published once the
+    // outermost load of the thread completes and every partial type it
+    // borrowed from other threads is finished.
+    struct LoadStack
+    {
+        size_t depth = 0;
+        bool ending = false;
+        std::vector<std::string> loaded;
+        std::vector<std::string> borrowed;
+    };
+
+    RegistryState() : table(new NameTable(256)), nextIndex(1)
+    {
+        tables.emplace_back(table.load());
+    }
+
+    // Guards everything but the lookups in table. Loaders run without holding
+    // it so that independent types can be loaded in parallel.
     std::mutex lock;
-    std::unordered_map<std::string, const Type*> types;
+    std::condition_variable loaded;
+
+    std::atomic<NameTable*> table;
+    IndexTable indexes;
+    std::atomic<TypeIndex> nextIndex;
+    std::vector< std::unique_ptr<NameTable> > tables;
+    std::vector< std::unique_ptr<NameTable::Entry> > entries;
+
+    std::vector<Type*> types;
+    PerfectHash<const Type*> sealed;
+
+    std::unordered_map<std::string, Loading> loading;
+    std::unordered_map<std::thread::id, LoadStack> stacks;
+    std::unordered_map<std::thread::id, std::string> waiting;
     std::unordered_map<std::string, std::string> aliases;
     std::unordered_map<std::string, std::function<void(Type*)> > loaders;
     Scope scopes;
-};
 
-RegistryState* registry_ = nullptr;
+    WarmupReport* report = nullptr;
+
+    std::mutex cacheLock;
+    TypeCache* caches = nullptr;
+
+    // Must be called while holding the lock.
+    void publish(std::string name, const Type* type)
+    {
+        NameTable* current = table.load(std::memory_order_relaxed);
+
+        if (current->full()) {
+            NameTable* next = new NameTable(current->capacity() * 2);
+            tables.emplace_back(next);
+
+            for (const auto& entry : entries) next->insert(entry.get());
+
+            table.store(next, std::memory_order_release);
+            current = next;
+        }
+
+        size_t hash = std::hash<std::string>()(name);
+        entries.emplace_back(new NameTable::Entry(hash, std::move(name), type));
+        current->insert(entries.back().get());
+    }
+
+    // Must be called while holding the lock.
+    void add(const std::string& id, const Type* type)
+    {
+        if (id.empty() || !type)
+            reflectError("can't add type for <%s>", id);
+
+        auto current = table.load(std::memory_order_relaxed);
+        if (current->find(id)) reflectError("<%s> already has a type", id);
+
+        publish(id, type);
+        indexes.insert(type->index(), type);
+
+        for (const auto& alias : aliases) {
+            if (alias.second == id) publish(alias.first, type);
+        }
+    }
+
+    // Must be called while holding the lock. True if a thread that's still
+    // running loaders holds an unfinished type owned by lender.
+    bool lentOut(std::thread::id lender) const
+    {
+        for (const auto& stack : stacks) {
+            if (stack.first == lender || stack.second.ending) continue;
+            if (borrows(stack.second, lender)) return true;
+        }
+        return false;
+    }
+
+    bool borrows(const LoadStack& stack, std::thread::id lender) const
+    {
+        for (const auto& id : stack.borrowed) {
+            auto it = loading.find(id);
+            if (it == loading.end()) continue;
+            if (it->second.owner == lender && !it->second.finished) return true;
+        }
+        return false;
+    }
+
+    // Must be called while holding the lock. A finished type can still point
+    // to partial types that its owner borrowed so we inherit those as well.
+    void borrow(const std::string& id, const Loading& entry)
+    {
+        auto& borrowed = stacks[std::this_thread::get_id()].borrowed;
+
+        if (!entry.finished) {
+            borrowed.push_back(id);
+            return;
+        }
+
+        const auto& other = stacks[entry.owner].borrowed;
+        borrowed.insert(borrowed.end(), other.begin(), other.end());
+    }
+
+    // Must be called while holding the lock. A blocked thread waits on the
+    // owner of the type it needs and, until they stop running, on the threads
+    // that borrowed its unfinished types.
+    template<typename Fn>
+    void forEachBlocker(std::thread::id thread, const Fn& fn) const
+    {
+        auto waitIt = waiting.find(thread);
+        if (waitIt == waiting.end()) return;
+
+        auto loadIt = loading.find(waitIt->second);
+        if (loadIt != loading.end()) fn(loadIt->second.owner);
+
+        for (const auto& stack : stacks) {
+            if (stack.first == thread || stack.second.ending) continue;
+            if (borrows(stack.second, thread)) fn(stack.first);
+        }
+    }
+
+    // Must be called while holding the lock. Waiting on a type owned by
+    // another thread deadlocks if that thread is, directly or through other
+    // threads, blocked on us.
+    bool deadlocks(std::thread::id owner) const
+    {
+        const auto self = std::this_thread::get_id();
+
+        std::vector<std::thread::id> todo { owner };
+        std::unordered_set<std::thread::id> visited { owner };
+
+        while (!todo.empty()) {
+            auto thread = todo.back();
+            todo.pop_back();
+
+            if (thread == self) return true;
+
+            forEachBlocker(thread, [&] (std::thread::id next) {
+                        if (visited.insert(next).second) todo.push_back(next);
+                    });
+        }
+
+        return false;
+    }
+
+    // Must be called while holding the lock which is released while the
+    // loader runs.
+    const Type* load(const std::string& id, std::unique_lock<std::mutex>& guard);
+
+    // Must be called while holding the lock. Unwinds a load whose loader
+    // threw so that the threads waiting on it can bail out.
+    void fail(const std::string& id)
+    {
+        auto& entry = loading.find(id)->second;
+        entry.finished = entry.failed = true;
+
+        const auto self = std::this_thread::get_id();
+        LoadStack& stack = stacks[self];
+
+        // The types that finished within the failed outermost load can't be
+        // published since they may point to the type that failed.
+        if (!--stack.depth) {
+            for (const auto& loadedId : stack.loaded)
+                loading.find(loadedId)->second.failed = true;
+
+            stacks.erase(self);
+            waiting.erase(self);
+        }
+
+        loaded.notify_all();
+    }
+};
 
 RegistryState& getRegistry()
 {
-    if (!registry_) registry_ = new RegistryState();
-    return *registry_;
+    // Function statics are initialized in a thread-safe manner and on
+    // first-use which also protects us from the static init order fiasco.
+    static RegistryState* registry = new RegistryState();
+    return *registry;
+}
+
+// Kept outside of RegistryState so that checking it doesn't have to go
+// through the function static guard of getRegistry().
+std::atomic<bool> isRegistrySealed(false);
+
+// Used to attribute loads to warmup threads and to exclude the time spent
+// loading dependencies from the time reported for a type.
+thread_local size_t warmupThread = 0;
+thread_local double nestedLoadTime = 0;
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+const Type*
+RegistryState::
+load(const std::string& id, std::unique_lock<std::mutex>& guard)
+{
+    if (id.empty()) reflectError("can't add type for <%s>", id);
+
+    auto it = loaders.find(id);
+    if (it == loaders.end())
+        reflectError("no loader found for <%s>", id);
+
+    auto loader = std::move(it->second);
+    loaders.erase(it);
+
+    // The type is only made visible to the lock-free lookups once it's fully
+    // loaded. Until then, it's only handed out to break recursive loads.
+    Type* type = new Type(id, nextIndex++);
+    types.push_back(type);
+
+    const auto self = std::this_thread::get_id();
+    loading.emplace(id, Loading{ type, self, false, false });
+
+    LoadStack& stack = stacks[self];
+    stack.depth++;
+
+    double nested = nestedLoadTime;
+    nestedLoadTime = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    // Relocks and unwinds the load if the loader throws.
+    struct FailGuard
+    {
+        RegistryState& registry;
+        std::unique_lock<std::mutex>& guard;
+        const std::string& id;
+        double nested;
+        bool done;
+
+        ~FailGuard()
+        {
+            if (done) return;
+
+            guard.lock();
+            nestedLoadTime = nested;
+            registry.fail(id);
+        }
+    } failGuard { *this, guard, id, nested, false };
+
+    guard.unlock();
+    {
+        // Types outlive any value arena that the caller might be using.
+        ValueArena::Suspend suspend;
+        loader(type);
+    }
+    guard.lock();
+    failGuard.done = true;
+
+    double elapsed = secondsSince(start);
+    double exclusive = elapsed - nestedLoadTime;
+    nestedLoadTime = nested + elapsed;
+
+    loading.find(id)->second.finished = true;
+    stack.loaded.push_back(id);
+
+    if (report)
+        report->types.push_back({ id, warmupThread, exclusive, type->footprint() });
+
+    // Finished types can be handed out to threads that are part of a cycle
+    // with us even if they're not published yet.
+    loaded.notify_all();
+    if (--stack.depth) return type;
+
+    // Publishing a type that points to a partial type would let any thread
+    // observe it while its owner is still busy loading it.
+    stack.ending = true;
+    loaded.notify_all();
+
+    for (const auto& borrowed : stack.borrowed) {
+        while (true) {
+            auto it = loading.find(borrowed);
+            if (it == loading.end() || it->second.finished) break;
+
+            waiting[self] = borrowed;
+            loaded.wait(guard);
+        }
+    }
+    waiting.erase(self);
+
+    for (const auto& loadedId : stack.loaded) {
+        auto it = loading.find(loadedId);
+        const Type* loadedType = it->second.type;
+
+        loading.erase(it);
+        add(loadedId, loadedType);
+    }
+
+    stacks.erase(self);
+    loaded.notify_all();
+
+    return type;
 }
 
 } // namespace anonymous
@@ -48,57 +487,139 @@ globalScope()
     return &getRegistry().scopes;
 }
 
+Arena&
+Registry::
+arena()
+{
+    static Arena* arena = new Arena;
+    return *arena;
+}
+
 const Type*
 Registry::
 get(const std::string& id)
 {
     auto& registry = getRegistry();
-    std::lock_guard<std::mutex>(registry.lock);
 
+    if (isSealed()) {
+        auto type = registry.sealed.find(id);
+        if (!type) reflectError("no loader found for <%s>", id);
+        return *type;
+    }
+
+    const Type* type = registry.table.load(std::memory_order_acquire)->find(id);
+    if (type) return type;
+
+    std::unique_lock<std::mutex> guard(registry.lock);
+
+    // Aliases are never removed so the pointer stays valid while we wait.
     const std::string* pId = &id;
 
     auto aliasIt = registry.aliases.find(*pId);
     if (aliasIt != registry.aliases.end())
         pId = &aliasIt->second;
 
-    auto typeIt = registry.types.find(*pId);
-    return typeIt != registry.types.end() ? typeIt->second : load(*pId);
-}
+    const auto self = std::this_thread::get_id();
+
+    while (true) {
+
+        // Partial types we handed out to break a cycle can't be modified until
+        // the threads that borrowed them are done with their loaders.
+        if (!registry.lentOut(self)) {
+
+            // Someone may have loaded the type while we were waiting.
+            type = registry.table.load(std::memory_order_relaxed)->find(*pId);
+            if (type) break;
+
+            auto loadingIt = registry.loading.find(*pId);
+            if (loadingIt == registry.loading.end()) {
+                registry.waiting.erase(self);
+                return registry.load(*pId, guard);
+            }
 
+            // Unpublished types are only handed out when waiting would never
+            // end which is how recursive definitions are resolved, whether
+            // the recursion happens within a thread or across threads.
+            const auto& entry = loadingIt->second;
+            if (entry.failed) {
+                registry.waiting.erase(self);
+                reflectError("unable to load <%s>", *pId);
+            }
+
+            if (entry.owner == self || registry.deadlocks(entry.owner)) {
+                if (entry.owner != self) registry.borrow(*pId, entry);
+
+                type = entry.type;
+                break;
+            }
+        }
+
+        registry.waiting[self] = *pId;
+        registry.loaded.wait(guard);
+    }
+
+    registry.waiting.erase(self);
+    return type;
+}
 
 const Type*
 Registry::
-load(const std::string& id)
+get(TypeIndex index)
 {
-    if (id.empty()) reflectError("can't add type for <%s>", id);
+    const Type* type = getRegistry().indexes.find(index);
+    if (!type) reflectError("no type loaded for index <%u>", index);
+    return type;
+}
 
+bool
+Registry::
+isLoaded(const Type* type)
+{
+    if (!type->index() || isSealed()) return true;
+    return getRegistry().indexes.find(type->index()) == type;
+}
+
+TypeIndex
+Registry::
+indexes()
+{
+    return getRegistry().nextIndex.load(std::memory_order_acquire);
+}
+
+const Type*
+Registry::
+cache(TypeCache& cache, const Type* type)
+{
     auto& registry = getRegistry();
 
-    auto it = registry.loaders.find(id);
-    if (it == registry.loaders.end())
-        reflectError("no loader found for <%s>", id);
+    // Types handed out to break recursive loads aren't done yet so caching
+    // them would make them visible to other threads.
+    if (!isSealed()) {
+        auto table = registry.table.load(std::memory_order_acquire);
+        if (table->find(type->id()) != type) return type;
+    }
 
-    auto loader = std::move(it->second);
-    registry.loaders.erase(it);
+    std::lock_guard<std::mutex> guard(registry.cacheLock);
 
-    Type* type;
-    add(id, type = new Type(id));
+    if (!cache.linked) {
+        cache.next = registry.caches;
+        registry.caches = &cache;
+        cache.linked = true;
+    }
 
-    loader(type);
+    cache.type.store(type, std::memory_order_release);
     return type;
 }
 
 void
 Registry::
-add(const std::string& id, const Type* type)
+clearCache()
 {
-    if (id.empty() || !type)
-        reflectError("can't add type for <%s>", id);
-
     auto& registry = getRegistry();
+    std::lock_guard<std::mutex> guard(registry.cacheLock);
 
-    auto ret = registry.types.emplace(id, type);
-    if (!ret.second) reflectError("<%s> already has a type", id);
+    for (TypeCache* it = registry.caches; it; it = it->next)
+        it->type.store(nullptr, std::memory_order_release);
 }
 
 void
@@ -109,7 +630,14 @@ add(const std::string& id, std::function<void(Type*)> loader)
         reflectError("can't add loader for<%s>", id);
 
     auto& registry = getRegistry();
-    std::lock_guard<std::mutex>(registry.lock);
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    // Template loaders register themselves on first use so a type that was
+    // loaded before the seal can still show up here.
+    if (isSealed()) {
+        if (registry.sealed.find(id)) return;
+        reflectError("can't add loader for <%s> to a sealed registry", id);
+    }
 
     // If we already have a loader then too-bad.
     registry.loaders.emplace(std::move(id), std::move(loader));
@@ -124,7 +652,10 @@ alias(const std::string& id, const std::string& alias)
         reflectError("<%s> can't be aliased to <%s>", alias, id);
 
     auto& registry = getRegistry();
-    std::lock_guard<std::mutex>(registry.lock);
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    if (isSealed())
+        reflectError("can't alias <%s> to <%s> in a sealed registry", alias, id);
 
     auto ret = registry.aliases.emplace(std::move(alias), std::move(id));
     if (!ret.second) {
@@ -132,6 +663,180 @@ alias(const std::string& id, const std::string& alias)
                 "<%s> can't be aliased to <%s> because it's already aliased to <%s>",
                 alias, id, ret.first->second);
     }
+
+    auto current = registry.table.load(std::memory_order_relaxed);
+    if (const Type* type = current->find(id)) registry.publish(alias, type);
+}
+
+
+/******************************************************************************/
+/* WARMUP                                                                     */
+/******************************************************************************/
+
+WarmupReport
+Registry::
+warmup(size_t threads, WarmupFilter filter)
+{
+    if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto& registry = getRegistry();
+
+    WarmupReport report;
+    report.threads = threads;
+
+    {
+        std::lock_guard<std::mutex> guard(registry.lock);
+        if (registry.report) reflectError("warmup is already in progress");
+        registry.report = &report;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Loading a type can register new loaders (templates mostly) so we keep
+    // going in rounds until there's nothing left that matches the filter.
+    while (true) {
+        std::vector<std::string> ids;
+        {
+            std::lock_guard<std::mutex> guard(registry.lock);
+            ids.reserve(registry.loaders.size());
+            for (const auto& loader : registry.loaders)
+                ids.push_back(loader.first);
+        }
+
+        // The filter is called without the lock in case it looks up types.
+        if (filter) {
+            auto it = std::remove_if(ids.begin(), ids.end(),
+                    [&] (const std::string& id) { return !filter(id); });
+            ids.erase(it, ids.end());
+        }
+        if (ids.empty()) break;
+
+        std::atomic<size_t> next(0);
+        auto run = [&] (size_t thread) {
+            warmupThread = thread;
+            for (size_t i = next++; i < ids.size(); i = next++)
+                get(ids[i]);
+        };
+
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < threads; ++i) pool.emplace_back(run, i + 1);
+        run(1);
+        for (auto& thread : pool) thread.join();
+
+        warmupThread = 0;
+    }
+
+    report.elapsed = secondsSince(start);
+
+    {
+        std::lock_guard<std::mutex> guard(registry.lock);
+        registry.report = nullptr;
+    }
+
+    return report;
+}
+
+WarmupReport
+Registry::
+warmup(const Scope* scope, size_t threads)
+{
+    std::string prefix = scope->id();
+    if (prefix.empty()) return warmup(threads);
+
+    prefix += "::";
+    return warmup(threads, [=] (const std::string& id) {
+                return !id.compare(0, prefix.size(), prefix);
+            });
+}
+
+size_t
+WarmupReport::
+memory() const
+{
+    size_t total = 0;
+    for (const auto& entry : types) total += entry.memory;
+    return total;
+}
+
+std::string
+WarmupReport::
+print() const
+{
+    std::vector<const Entry*> sorted;
+    sorted.reserve(types.size());
+    for (const auto& entry : types) sorted.push_back(&entry);
+
+    std::sort(sorted.begin(), sorted.end(), [] (const Entry* lhs, const Entry* rhs) {
+                return lhs->elapsed > rhs->elapsed;
+            });
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+
+    ss << "warmup: " << types.size() << " types, "
+        << threads << " threads, "
+        << (elapsed * 1000) << "ms, "
+        << memory() << " bytes\n";
+
+    for (const Entry* entry : sorted) {
+        ss << "    "
+            << std::setw(10) << (entry->elapsed * 1000) << "ms "
+            << std::setw(10) << entry->memory << "b "
+            << "  t" << std::setw(2) << std::left << entry->thread << std::right
+            << "  " << entry->id << "\n";
+    }
+
+    return ss.str();
+}
+
+
+/******************************************************************************/
+/* SEAL                                                                       */
+/******************************************************************************/
+
+bool
+Registry::
+isSealed()
+{
+    return isRegistrySealed.load(std::memory_order_acquire);
+}
+
+void
+Registry::
+seal()
+{
+    auto& registry = getRegistry();
+    std::unique_lock<std::mutex> guard(registry.lock);
+
+    if (isSealed()) return;
+
+    // Loaders can register new loaders (templates mostly) and other threads
+    // may still be busy loading so keep going until we reach a fixed point.
+    while (!registry.loaders.empty() || !registry.loading.empty()) {
+        if (registry.loaders.empty()) {
+            registry.loaded.wait(guard);
+            continue;
+        }
+
+        std::string id = registry.loaders.begin()->first;
+        registry.load(id, guard);
+    }
+
+    std::vector< std::pair<std::string, const Type*> > names;
+    names.reserve(registry.entries.size());
+
+    for (const auto& entry : registry.entries)
+        names.emplace_back(entry->name, entry->type);
+
+    // Sealing the scopes resolves the types they lazily load so it has to
+    // happen before we seal the types. Everything is loaded at this point so
+    // these lookups never need the lock we're holding.
+    registry.scopes.seal();
+    for (Type* type : registry.types) type->seal();
+    registry.sealed = PerfectHash<const Type*>(std::move(names));
+
+    // Publishes all the sealed tables built above to the lookups.
+    isRegistrySealed.store(true, std::memory_order_release);
 }
 
 
@@ -13,6 +13,20 @@ namespace reflect {
 struct Type;
 
 
+/******************************************************************************/
+/* TYPE INDEX                                                                 */
+/******************************************************************************/
+
+/** Small dense integer assigned to every type when it's loaded which makes it
+    possible to key per-type side tables with a plain vector. Index 0 is never
+    assigned and can be used to represent the absence of a type.
+
+    Indexes are handed out in load order so they're only meaningful within the
+    process that assigned them.
+ */
+typedef uint32_t TypeIndex;
+
+
 /******************************************************************************/
 /* REFLECT                                                                    */
 /******************************************************************************/
@@ -22,6 +36,70 @@ template<typename T, typename Enable = void> struct ReflectScope;
 template<typename T, typename Enable = void> struct Loader;
 
 
+/******************************************************************************/
+/* TYPE CACHE                                                                 */
+/******************************************************************************/
+
+/** Memoizes the Type associated with a C++ type so that type<T>() only has to
+    build the id string and go through the registry's maps the first time it's
+    called. Entries are linked in a global list the first time they're filled
+    so that they can all be reset via Registry::clearCache().
+ */
+struct TypeCache
+{
+    constexpr TypeCache() : type(nullptr), next(nullptr), linked(false) {}
+
+    const Type* get() const { return type.load(std::memory_order_acquire); }
+
+private:
+    friend struct Registry;
+
+    std::atomic<const Type*> type;
+    TypeCache* next;
+    bool linked;
+};
+
+template<typename T>
+struct TypeCacheEntry
+{
+    static TypeCache cache;
+};
+
+template<typename T> TypeCache TypeCacheEntry<T>::cache;
+
+
+/******************************************************************************/
+/* WARMUP REPORT                                                              */
+/******************************************************************************/
+
+/** Summary of the types loaded by Registry::warmup(). Loads triggered by
+    threads outside of the pool while the warmup is running are also recorded
+    and are attributed to thread 0.
+ */
+struct WarmupReport
+{
+    struct Entry
+    {
+        std::string id;
+        size_t thread;
+
+        // Excludes the time spent loading dependencies but includes the time
+        // spent waiting on dependencies loaded by other threads.
+        double elapsed;
+
+        // Rough estimate; see Type::footprint().
+        size_t memory;
+    };
+
+    size_t threads = 0;
+    double elapsed = 0;
+    std::vector<Entry> types;
+
+    size_t memory() const;
+    std::string print() const;
+};
+
+
 /******************************************************************************/
 /* REGISTRY                                                                   */
 /******************************************************************************/
@@ -33,11 +111,25 @@ struct Registry
     {
         typedef typename CleanType<T>::type CleanT;
 
+        TypeCache& cache = TypeCacheEntry<CleanT>::cache;
+        if (const Type* type = cache.get()) return type;
+
         Reflect<CleanT>::loader();
-        return get(Reflect<CleanT>::id());
+        return Registry::cache(cache, get(Reflect<CleanT>::id()));
     }
 
     static const Type* get(const std::string& id);
+    static const Type* get(TypeIndex index);
+
+    // True once the type is fully loaded and visible to all threads. Types
+    // that weren't created by the registry are always considered loaded.
+    static bool isLoaded(const Type* type);
+
+    // Upper bound (exclusive) of all the type indexes assigned so far.
+    static TypeIndex indexes();
+
+    // Forgets every Type resolved through type<T>(). Mostly useful for tests.
+    static void clearCache();
 
     template<typename T>
     static void add()
@@ -60,9 +152,38 @@ struct Registry
 
     static Scope* globalScope();
 
+    // Holds the function metadata of every reflected type. Never destroyed
+    // since types outlive static destruction.
+    static Arena& arena();
+
+    typedef std::function<bool(const std::string& id)> WarmupFilter;
+
+    /** Eagerly loads every pending loader accepted by the filter on a pool of
+        threads (hardware concurrency if 0) so that the cost of building the
+        types isn't paid by the first lookups. Dependencies between types are
+        loaded on demand by whichever thread needs them first and it's safe
+        to look up types while the warmup is running.
+
+        Traits are only known once a type is loaded so filtering can only be
+        done on ids.
+     */
+    static WarmupReport warmup(size_t threads = 0, WarmupFilter filter = {});
+    static WarmupReport warmup(const Scope* scope, size_t threads = 0);
+
+    /** Loads every pending loader and freezes all the reflected metadata
+        into immutable perfect hash tables. Any attempt to add types,
+        aliases, functions, fields or traits afterwards is an error which
+        includes instantiating a template type that was never used before the
+        seal.
+
+        Meant to be called once startup is over and before the lookups start
+        to matter.
+     */
+    static void seal();
+    static bool isSealed();
+
 private:
-    static void add(const std::string& id, const Type* type);
-    static const Type* load(const std::string& id);
+    static const Type* cache(TypeCache& cache, const Type* type);
 };
 
 
@@ -92,6 +213,11 @@ inline const Type* type(const std::string& id)
     return Registry::get(id);
 }
 
+inline const Type* type(TypeIndex index)
+{
+    return Registry::get(index);
+}
+
 
 /******************************************************************************/
 /* SCOPE                                                                      */
@@ -165,10 +165,23 @@ hasScope(const std::string& name) const
 {
     auto split = head(name);
 
-    auto it = scopes_.find(split.first);
-    if (it == scopes_.end()) return false;
+    Scope* child = findScope(split.first);
+    if (!child) return false;
 
-    return !split.second.empty() ? it->second->hasScope(split.second) : true;
+    return !split.second.empty() ? child->hasScope(split.second) : true;
+}
+
+Scope*
+Scope::
+findScope(const std::string& name) const
+{
+    if (Registry::isSealed()) {
+        auto it = sealedScopes_.find(name);
+        return it ? *it : nullptr;
+    }
+
+    auto it = scopes_.find(name);
+    return it != scopes_.end() ? it->second : nullptr;
 }
 
 Scope*
@@ -177,11 +190,11 @@ scope(const std::string& name) const
 {
     auto split = head(name);
 
-    auto it = scopes_.find(split.first);
-    if (it == scopes_.end())
+    Scope* child = findScope(split.first);
+    if (!child)
         reflectError("<%s> doesn't have scope <%s>", name_, name);
 
-    return !split.second.empty() ? it->second->scope(split.second) : it->second;
+    return !split.second.empty() ? child->scope(split.second) : child;
 }
 
 Scope*
@@ -190,13 +203,16 @@ scope(const std::string& name)
 {
     auto split = head(name);
 
-    auto it = scopes_.find(split.first);
-    if (it == scopes_.end()) {
+    Scope* child = findScope(split.first);
+    if (!child) {
+        if (Registry::isSealed())
+            reflectError("can't add scope <%s> to a sealed registry", name);
+
         std::unique_ptr<Scope> scope(new Scope(split.first, this));
-        it = scopes_.emplace(split.first, scope.release()).first;
+        child = scopes_.emplace(split.first, scope.release()).first->second;
     }
 
-    return !split.second.empty() ? it->second->scope(split.second) : it->second;
+    return !split.second.empty() ? child->scope(split.second) : child;
 }
 
 
@@ -233,14 +249,17 @@ hasType(const std::string& name)
 {
     auto split = head(name);
 
-    auto it = types_.find(split.first);
-    if (it == types_.end()) {
+    bool found = Registry::isSealed() ?
+        sealedTypes_.find(split.first) != nullptr :
+        types_.count(split.first) > 0;
+
+    if (!found) {
         if (split.second.empty()) return false;
 
-        auto scopeIt = scopes_.find(split.first);
-        if (scopeIt == scopes_.end()) return false;
+        Scope* child = findScope(split.first);
+        if (!child) return false;
 
-        return scopeIt->second->hasType(split.second);
+        return child->hasType(split.second);
     }
 
     if (!split.second.empty())
@@ -255,14 +274,22 @@ type(const std::string& name)
 {
     auto split = head(name);
 
+    if (Registry::isSealed()) {
+        if (auto type = sealedTypes_.find(split.first)) {
+            if (!split.second.empty())
+                reflectError("Type doesn't support inner classes yet");
+            return *type;
+        }
+    }
+
     auto it = types_.find(split.first);
     if (it == types_.end()) {
 
-        auto scopeIt = scopes_.find(split.first);
-        if (split.second.empty() || scopeIt == scopes_.end())
+        Scope* child = findScope(split.first);
+        if (split.second.empty() || !child)
             reflectError("unknown type <%s::%s>", id(), split.first);
 
-        return scopeIt->second->type(split.second);
+        return child->type(split.second);
     }
 
     // lazy load the type.
@@ -280,6 +307,9 @@ void
 Scope::
 addType(const std::string& name)
 {
+    if (Registry::isSealed())
+        reflectError("can't add type <%s> to a sealed registry", name);
+
     auto split = head(name);
 
     if (split.second.empty()) {
@@ -313,6 +343,9 @@ addFunction(const std::string& name, Function&& fn)
     if (!split.second.empty())
         return scope(split.second)->addFunction(split.first, std::move(fn));
 
+    if (Registry::isSealed())
+        reflectError("can't add function <%s> to a sealed registry", name);
+
     functions_[split.first].add(std::move(fn));
 }
 
@@ -348,8 +381,20 @@ hasFunction(const std::string& name) const
     if (!split.second.empty())
         return scope(split.second)->hasFunction(split.first);
 
-    auto it = functions_.find(split.first);
-    return it != functions_.end();
+    return findFunction(split.first);
+}
+
+Overloads*
+Scope::
+findFunction(const std::string& name) const
+{
+    if (Registry::isSealed()) {
+        auto it = sealedFns_.find(name);
+        return it ? *it : nullptr;
+    }
+
+    auto it = functions_.find(name);
+    return it != functions_.end() ? const_cast<Overloads*>(&it->second) : nullptr;
 }
 
 Overloads&
@@ -361,11 +406,11 @@ function(const std::string& name)
     if (!split.second.empty())
         return scope(split.second)->function(split.first);
 
-    auto it = functions_.find(split.first);
-    if (it == functions_.end())
+    Overloads* fns = findFunction(split.first);
+    if (!fns)
         reflectError("<%s> has no function <%s>", id(), split.first);
 
-    return it->second;
+    return *fns;
 }
 
 const Overloads&
@@ -375,4 +420,45 @@ function(const std::string& name) const
     return const_cast<Scope*>(this)->function(name);
 }
 
+
+
+/******************************************************************************/
+/* SEAL                                                                       */
+/******************************************************************************/
+
+void
+Scope::
+seal()
+{
+    Traits::seal();
+
+    std::vector< std::pair<std::string, Scope*> > scopes;
+    scopes.reserve(scopes_.size());
+
+    for (auto& scope : scopes_) {
+        scope.second->seal();
+        scopes.emplace_back(scope.first, scope.second);
+    }
+
+    std::vector< std::pair<std::string, const Type*> > types;
+    types.reserve(types_.size());
+
+    for (auto& type : types_) {
+        if (!type.second) type.second = reflect::type(join(id(), type.first));
+        types.emplace_back(type.first, type.second);
+    }
+
+    std::vector< std::pair<std::string, Overloads*> > fns;
+    fns.reserve(functions_.size());
+
+    for (auto& fn : functions_) {
+        fn.second.seal();
+        fns.emplace_back(fn.first, &fn.second);
+    }
+
+    sealedScopes_ = PerfectHash<Scope*>(std::move(scopes));
+    sealedTypes_ = PerfectHash<const Type*>(std::move(types));
+    sealedFns_ = PerfectHash<Overloads*>(std::move(fns));
+}
+
 } // reflect
@@ -59,8 +59,14 @@ struct Scope : public Traits
     static std::pair<std::string, std::string> head(const std::string& name);
     static std::pair<std::string, std::string> tail(const std::string& name);
 
+    // Called by Registry::seal().
+    void seal();
+
 private:
 
+    Scope* findScope(const std::string& name) const;
+    Overloads* findFunction(const std::string& name) const;
+
     std::string name_;
 
     Scope* parent_;
@@ -68,6 +74,10 @@ private:
 
     std::unordered_map<std::string, const Type*> types_;
     std::unordered_map<std::string, Overloads> functions_;
+
+    PerfectHash<Scope*> sealedScopes_;
+    PerfectHash<const Type*> sealedTypes_;
+    PerfectHash<Overloads*> sealedFns_;
 };
 
 } // reflect
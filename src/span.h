@@ -0,0 +1,61 @@
+/* span.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Non-owning view over a contiguous range of objects.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* SPAN                                                                       */
+/******************************************************************************/
+
+template<typename T>
+struct Span
+{
+    Span() : data_(nullptr), size_(0) {}
+    Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    template<typename U>
+    Span(std::vector<U>& vec) : data_(vec.data()), size_(vec.size()) {}
+
+    template<typename U>
+    Span(const std::vector<U>& vec) : data_(vec.data()), size_(vec.size()) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return !size_; }
+
+    T& operator[] (size_t i) const { return data_[i]; }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+template<typename T>
+Span<T> span(T* data, size_t size)
+{
+    return Span<T>(data, size);
+}
+
+template<typename T>
+Span<T> span(std::vector<T>& vec)
+{
+    return Span<T>(vec);
+}
+
+template<typename T>
+Span<const T> span(const std::vector<T>& vec)
+{
+    return Span<const T>(vec);
+}
+
+} // reflect
@@ -0,0 +1,78 @@
+/* status.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Status implementation.
+*/
+
+#include "reflect.h"
+
+namespace reflect {
+
+/******************************************************************************/
+/* STATUS CODE                                                                */
+/******************************************************************************/
+
+std::ostream& operator<<(std::ostream& stream, StatusCode code)
+{
+    switch(code)
+    {
+    case StatusCode::Ok:          stream << "Ok"; break;
+    case StatusCode::NoField:     stream << "NoField"; break;
+    case StatusCode::NoFunction:  stream << "NoFunction"; break;
+    case StatusCode::NoOverload:  stream << "NoOverload"; break;
+    case StatusCode::Ambiguous:   stream << "Ambiguous"; break;
+    case StatusCode::NotCastable: stream << "NotCastable"; break;
+    case StatusCode::NotMovable:  stream << "NotMovable"; break;
+    case StatusCode::NotCopiable: stream << "NotCopiable"; break;
+    default: reflectError("unknown status code");
+    };
+
+    return stream;
+}
+
+
+/******************************************************************************/
+/* STATUS                                                                     */
+/******************************************************************************/
+
+std::string
+Status::
+message() const
+{
+    const Type* type = static_cast<const Type*>(subject);
+    const Overloads* fn = static_cast<const Overloads*>(subject);
+
+    switch(code_)
+    {
+    case StatusCode::Ok: return "";
+
+    case StatusCode::NoField:
+        return errorFormat("<%s> doesn't have the requested field", type->id());
+
+    case StatusCode::NoFunction:
+        return errorFormat(
+                "<%s> doesn't have the requested function", type->id());
+
+    case StatusCode::NoOverload:
+        return errorFormat(
+                "no overload available for function <%s>", fn->name());
+
+    case StatusCode::Ambiguous:
+        return errorFormat(
+                "ambiguous function call for function <%s>", fn->name());
+
+    case StatusCode::NotCastable:
+        return errorFormat("value is not castable to <%s>", type->id());
+
+    case StatusCode::NotMovable:
+        return errorFormat("value is not movable to <%s>", type->id());
+
+    case StatusCode::NotCopiable:
+        return errorFormat("value is not copiable to <%s>", type->id());
+
+    default: reflectUnreachable();
+    }
+}
+
+} // reflect
@@ -0,0 +1,61 @@
+/* status.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Outcome of the non-throwing try* operations.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* STATUS CODE                                                                */
+/******************************************************************************/
+
+enum struct StatusCode : uint8_t
+{
+    Ok,
+    NoField,
+    NoFunction,
+    NoOverload,
+    Ambiguous,
+    NotCastable,
+    NotMovable,
+    NotCopiable,
+};
+
+std::ostream& operator<<(std::ostream& stream, StatusCode code);
+
+
+/******************************************************************************/
+/* STATUS                                                                     */
+/******************************************************************************/
+
+/** Records why a try* operation failed without formatting anything. Failures
+    are expected when probing so a Status is only a code and a pointer to what
+    failed: the Overloads for a failed call and the Type otherwise. The message
+    is only built if asked for which means that the Status must not outlive
+    what it points to.
+ */
+struct Status
+{
+    Status() : code_(StatusCode::Ok), subject(nullptr) {}
+
+    // type is the one that's missing the member or the target of a cast.
+    Status(StatusCode code, const Type* type) : code_(code), subject(type) {}
+    Status(StatusCode code, const Overloads* fn) : code_(code), subject(fn) {}
+
+    StatusCode code() const { return code_; }
+    bool ok() const { return code_ == StatusCode::Ok; }
+    explicit operator bool() const { return ok(); }
+
+    std::string message() const;
+
+private:
+    StatusCode code_;
+    const void* subject;
+};
+
+} // reflect
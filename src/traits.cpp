@@ -7,8 +7,70 @@
 
 #include "reflect.h"
 
+#include <mutex>
+
 namespace reflect {
 
+/******************************************************************************/
+/* TRAIT KEY                                                                  */
+/******************************************************************************/
+
+namespace {
+
+struct TraitKeys
+{
+    TraitKeys()
+    {
+        for (const char* name : {
+                    "pointer", "smartPtr", "list", "map", "json",
+                    "primitive", "void", "bool", "integer", "signed",
+                    "unsigned", "float", "string", "keyType", "valueType",
+                    "sizeof", "alignof", "trivial" })
+            intern(name);
+    }
+
+    TraitKey intern(const std::string& trait)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        auto it = keys.find(trait);
+        if (it != keys.end()) return it->second;
+
+        names.emplace_back(new std::string(trait));
+        return keys[trait] = names.size() - 1;
+    }
+
+    const std::string& name(TraitKey key)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return *names.at(key);
+    }
+
+private:
+    std::mutex lock;
+    std::unordered_map<std::string, TraitKey> keys;
+    std::vector< std::unique_ptr<std::string> > names;
+};
+
+TraitKeys& traitKeys()
+{
+    static TraitKeys keys;
+    return keys;
+}
+
+} // namespace anonymous
+
+TraitKey traitKey(const std::string& trait)
+{
+    return traitKeys().intern(trait);
+}
+
+const std::string& traitName(TraitKey key)
+{
+    return traitKeys().name(key);
+}
+
+
 /******************************************************************************/
 /* TRAITS                                                                     */
 /******************************************************************************/
@@ -17,9 +79,16 @@ void
 Traits::
 addTrait(const std::string& trait, Value value)
 {
+    if (Registry::isSealed())
+        reflectError("can't add trait <%s> to a sealed registry", trait);
+
     if (traits_.count(trait))
         reflectError("trait <%s> already exists", trait);
 
+    TraitKey key = traitKey(trait);
+    if (key < FlagBits) flags_ |= uint64_t(1) << key;
+
+    values_.emplace_back(key, value);
     traits_[trait] = std::move(value);
 }
 
@@ -40,7 +109,42 @@ bool
 Traits::
 is(const std::string& trait) const
 {
-    return traits_.count(trait);
+    return findTrait(trait);
+}
+
+bool
+Traits::
+is(TraitKey trait) const
+{
+    if (trait < FlagBits) return flags_ & (uint64_t(1) << trait);
+    return findTrait(trait);
+}
+
+const Value*
+Traits::
+findTrait(TraitKey trait) const
+{
+    for (const auto& value : values_) {
+        if (value.first == trait) return &value.second;
+    }
+    return nullptr;
+}
+
+const Value*
+Traits::
+findTrait(const std::string& trait) const
+{
+    if (Registry::isSealed()) return sealed_.find(trait);
+
+    auto it = traits_.find(trait);
+    return it != traits_.end() ? &it->second : nullptr;
+}
+
+void
+Traits::
+seal()
+{
+    sealed_ = PerfectHash<Value>({ traits_.begin(), traits_.end() });
 }
 
 std::string
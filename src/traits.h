@@ -10,12 +10,55 @@
 
 namespace reflect {
 
+/******************************************************************************/
+/* TRAIT KEY                                                                  */
+/******************************************************************************/
+
+/** Interned trait name. The first keys are reserved for the traits that the
+    library itself queries and, along with any other key small enough, are
+    stored as bits so that checking for them is a single AND. TraitKey is
+    declared in reflect.h since Value needs it.
+ */
+TraitKey traitKey(const std::string& trait);
+const std::string& traitName(TraitKey key);
+
+namespace traits {
+
+enum : TraitKey
+{
+    Pointer = 0,
+    SmartPtr,
+    List,
+    Map,
+    Json,
+    Primitive,
+    Void,
+    Bool,
+    Integer,
+    Signed,
+    Unsigned,
+    Float,
+    String,
+    KeyType,
+    ValueType,
+    Sizeof,
+    Alignof,
+    Trivial,
+
+    WellKnown
+};
+
+} // namespace traits
+
+
 /******************************************************************************/
 /* TRAITS                                                                     */
 /******************************************************************************/
 
 struct Traits
 {
+    Traits() : flags_(0) {}
+
     template<typename T>
     void addTrait(const std::string& trait, T&& value);
     void addTrait(const std::string& trait, Value value = {});
@@ -23,16 +66,40 @@ struct Traits
     std::vector<std::string> traits() const;
 
     bool is(const std::string& trait) const;
+    bool is(TraitKey trait) const;
 
     template<typename Ret>
     Ret getValue(const std::string& trait) const;
 
+    template<typename Ret>
+    Ret getValue(TraitKey trait) const;
+
+    /** Typed slot that's read in place: returns null if the trait doesn't
+        exist and errors if its value isn't exactly of type T.
+     */
+    template<typename T>
+    const T* findValue(TraitKey trait) const;
+
+    // Called by Registry::seal().
+    void seal();
+
 protected:
 
     std::string print() const;
+    const Value* findTrait(const std::string& trait) const;
+    const Value* findTrait(TraitKey trait) const;
 
 private:
+    enum { FlagBits = 64 };
+
     std::unordered_map<std::string, Value> traits_;
+    PerfectHash<Value> sealed_;
+
+    // Values share their storage with the ones in traits_ so the slots stay
+    // valid when the object is copied or moved. Trait values are never
+    // temporaries so they're never inline (see IsInlineValue).
+    uint64_t flags_;
+    std::vector< std::pair<TraitKey, Value> > values_;
 };
 
 } // namespace reflect
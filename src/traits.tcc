@@ -27,11 +27,37 @@ Ret
 Traits::
 getValue(const std::string& trait) const
 {
-    auto it = traits_.find(trait);
-    if (it != traits_.end())
-        return retCast<Ret>(it->second);
+    if (const Value* value = findTrait(trait))
+        return retCast<Ret>(*value);
 
     reflectError("trait <%s> doesn't exist", trait);
 }
 
+template<typename Ret>
+Ret
+Traits::
+getValue(TraitKey trait) const
+{
+    if (const Value* value = findTrait(trait))
+        return retCast<Ret>(*value);
+
+    reflectError("trait <%s> doesn't exist", traitName(trait));
+}
+
+template<typename T>
+const T*
+Traits::
+findValue(TraitKey trait) const
+{
+    const Value* value = findTrait(trait);
+    if (!value) return nullptr;
+
+    if (value->type() != type<T>()) {
+        reflectError("trait <%s> of type <%s> can't be read as <%s>",
+                traitName(trait), value->type()->id(), type<T>()->id());
+    }
+
+    return static_cast<const T*>(value->value());
+}
+
 } // namespace reflect
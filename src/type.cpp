@@ -9,27 +9,100 @@
 
 #include <algorithm>
 #include <sstream>
+#include <mutex>
 
 namespace reflect {
 
+namespace {
+
+// Guards the member tables and the children lists of every type. Only taken
+// when a table is built or when a type is modified.
+std::mutex membersLock;
+
+const std::string ConverterPrefix = "operator ";
+const std::string ConverterSuffix = "()";
+
+std::string converterName(const Type* target)
+{
+    return ConverterPrefix + target->id() + ConverterSuffix;
+}
+
+// Extracts the target id out of a "operator <id>()" function name.
+bool isConverterName(const std::string& name, std::string& target)
+{
+    size_t affixes = ConverterPrefix.size() + ConverterSuffix.size();
+    if (name.size() <= affixes) return false;
+
+    if (name.compare(0, ConverterPrefix.size(), ConverterPrefix)) return false;
+
+    size_t suffix = name.size() - ConverterSuffix.size();
+    if (name.compare(suffix, ConverterSuffix.size(), ConverterSuffix)) return false;
+
+    target = name.substr(ConverterPrefix.size(), name.size() - affixes);
+    return true;
+}
+
+std::mutex pointerKindsLock;
+std::unordered_map<std::string, size_t> pointerKinds;
+
+// Maps a pointer kind to a small non-zero integer so that pointer types can be
+// compared without comparing strings.
+size_t internPointerKind(const std::string& pointer)
+{
+    std::lock_guard<std::mutex> guard(pointerKindsLock);
+    return pointerKinds.emplace(pointer, pointerKinds.size() + 1).first->second;
+}
+
+} // namespace anonymous
+
+
 /******************************************************************************/
 /* TYPE                                                                       */
 /******************************************************************************/
 
 Type::
-Type(std::string id) :
-    id_(std::move(id)), parent_(nullptr), pointee_(nullptr)
+Type(std::string id, TypeIndex index) :
+    id_(std::move(id)), index_(index), parent_(nullptr),
+    pointerKind_(0), pointee_(nullptr),
+    numberKind_(NumberKind::None),
+    destructor_(nullptr),
+    members_(nullptr),
+    uncachedMembers_(nullptr)
 {}
 
+void
+Type::
+parent(const Type* parent)
+{
+    if (Registry::isSealed())
+        reflectError("can't set parent of <%s> in a sealed registry", id_);
+
+    parent_ = parent;
+
+    if (parent) {
+        std::lock_guard<std::mutex> guard(membersLock);
+        parent->children_.push_back(this);
+    }
+
+    invalidate();
+}
+
 bool
 Type::
 isChildOf(const Type* other) const
 {
     if (this == other) return true;
 
-    if (isPointer() && other->isPointer()) {
-        if (pointer() != other->pointer()) return false;
-        return pointee()->isChildOf(other->pointee());
+    if (pointerKind_ && other->pointerKind_) {
+        if (pointerKind_ != other->pointerKind_) return false;
+        return pointee_->isChildOf(other->pointee_);
+    }
+
+    const Members* members = this->members();
+    const Members* target = members ? other->members() : nullptr;
+    if (target) {
+        return target->depth <= members->depth
+            && members->display[target->depth] == other;
     }
 
     return parent_ && parent_->isChildOf(other);
@@ -46,51 +119,110 @@ bool
 Type::
 hasConverter(const Type* other) const
 {
-    return hasFunction("operator " + other->id() + "()");
+    if (const Members* members = this->members())
+        return members->converters.find(other->id()) != nullptr;
+
+    return hasFunction(converterName(other));
 }
 
 const Function&
 Type::
 converter(const Type* other) const
 {
-    auto& fns = function("operator " + other->id() + "()");
+    const Overloads* fns;
+
+    if (const Members* members = this->members()) {
+        auto it = members->converters.find(other->id());
+        if (!it) reflectError("<%s> has no converter for <%s>", id_, other->id());
+        fns = *it;
+    }
+    else fns = &function(converterName(other));
 
-    if (fns.size() > 1) {
+    if (fns->size() > 1) {
         reflectError("<%s> has too many converters for <%s>",
                 id_, other->id());
     }
 
-    return fns[0];
+    return (*fns)[0];
 }
 
 bool
 Type::
 isCopiable() const
 {
-    if (!hasFunction(id_)) return false;
-
-    auto& fns = function(id_);
-    return fns.test(
-            Argument(this, RefType::Copy, false),
-            { Argument(this, RefType::Copy, false) });
+    return construction() & Members::Copiable;
 }
 
 bool
 Type::
 isMovable() const
 {
-    if (!hasFunction(id_)) return false;
+    return construction() & Members::Movable;
+}
+
+bool
+Type::
+isTriviallyCopyable() const
+{
+    return construction() & Members::Trivial;
+}
+
+size_t
+Type::
+size() const
+{
+    const size_t* size = findValue<size_t>(traits::Sizeof);
+    return size ? *size : 0;
+}
+
+size_t
+Type::
+alignment() const
+{
+    const size_t* align = findValue<size_t>(traits::Alignof);
+    return align ? *align : 0;
+}
+
+/** Overload resolution is only done once per type if the member table is
+    cached. Racing threads compute the same flags so there's no need to lock.
+ */
+unsigned
+Type::
+construction() const
+{
+    const Members* members = this->members();
+    if (members) {
+        unsigned flags = members->construction.load(std::memory_order_acquire);
+        if (flags) return flags;
+    }
 
-    auto& fns = function(id_);
-    return fns.test(
-            Argument(this, RefType::Copy, false),
-            { Argument(this, RefType::RValue, false) });
+    unsigned flags = Members::Known;
+
+    if (hasFunction(id_)) {
+        auto& fns = function(id_);
+        Argument ret(this, RefType::Copy, false);
+
+        if (fns.test(ret, { Argument(this, RefType::Copy, false) }))
+            flags |= Members::Copiable;
+        if (fns.test(ret, { Argument(this, RefType::RValue, false) }))
+            flags |= Members::Movable;
+    }
+
+    bool copiable = flags & Members::Copiable;
+    if (copiable && is(traits::Trivial) && size() && alignment())
+        flags |= Members::Trivial;
+
+    if (members) members->construction.store(flags, std::memory_order_release);
+    return flags;
 }
 
 void
 Type::
 addFunction(const std::string& name, Function&& fn)
 {
+    if (Registry::isSealed())
+        reflectError("can't add function <%s> to <%s> in a sealed registry", name, id_);
+
     auto it = fields_.find(name);
     if (it != fields_.end()) {
         reflectError("function <%s> already exists as field <%s> in <%s>",
@@ -98,69 +230,81 @@ addFunction(const std::string& name, Function&& fn)
     }
 
     fns_[name].add(std::move(fn));
+    invalidate();
 }
 
-void
+const std::vector<std::string>&
 Type::
-functions(std::vector<std::string>& result) const
+functions() const
 {
-    result.reserve(result.size() + fns_.size());
-
-    for (const auto& f : fns_)
-        result.push_back(f.first);
-
-    if (parent_) parent_->functions(result);
+    if (const Members* members = this->members())
+        return members->functionNames;
+    return uncachedMembers().functionNames;
 }
 
-std::vector<std::string>
+bool
 Type::
-functions() const
+hasFunction(const std::string& fn) const
 {
-    std::vector<std::string> result;
-    functions(result);
-
-    std::sort(result.begin(), result.end());
-    result.erase(std::unique(result.begin(), result.end()), result.end());
+    if (const Members* members = this->members())
+        return members->functions.find(fn) != nullptr;
 
-    return result;
+    if (findFunction(fn)) return true;
+    return parent_ ? parent_->hasFunction(fn) : false;
 }
 
-bool
+Overloads*
 Type::
-hasFunction(const std::string& fn) const
+findFunction(const std::string& fn) const
 {
-    if (fns_.count(fn)) return true;
-    return parent_ ? parent_->hasFunction(fn) : false;
+    if (Registry::isSealed()) {
+        auto it = sealedFns_.find(fn);
+        return it ? *it : nullptr;
+    }
+
+    auto it = fns_.find(fn);
+    return it != fns_.end() ? const_cast<Overloads*>(&it->second) : nullptr;
 }
 
 Overloads&
 Type::
 function(const std::string& fn)
 {
-    auto it = fns_.find(fn);
-    if (it == fns_.end())
+    Overloads* fns = findFunction(fn);
+    if (!fns)
         reflectError("<%s> doesn't have an immediate function <%s>", id_, fn);
 
-    return it->second;
+    return *fns;
 }
 
 const Overloads&
 Type::
 function(const std::string& fn) const
 {
-    auto it = fns_.find(fn);
-    if (it != fns_.end()) return it->second;
+    if (const Overloads* fns = tryFunction(fn)) return *fns;
+    reflectError("<%s> doesn't have a function <%s>", id_, fn);
+}
 
-    if (!parent_)
-        reflectError("<%s> doesn't have a function <%s>", id_, fn);
+const Overloads*
+Type::
+tryFunction(const std::string& fn) const
+{
+    if (const Members* members = this->members()) {
+        auto fns = members->functions.find(fn);
+        return fns ? *fns : nullptr;
+    }
 
-    return parent_->function(fn);
+    if (const Overloads* fns = findFunction(fn)) return fns;
+    return parent_ ? parent_->tryFunction(fn) : nullptr;
 }
 
 void
 Type::
 addField(const std::string& name, Field&& field)
 {
+    if (Registry::isSealed())
+        reflectError("can't add field <%s> to <%s> in a sealed registry", name, id_);
+
     auto it = fns_.find(name);
     if (it != fns_.end()) {
         reflectError("field <%s> already exists as function <%s> in <%s>",
@@ -172,70 +316,194 @@ addField(const std::string& name, Field&& field)
         reflectError("field <%s> already exists as field <%s> in <%s>",
                 field.print(), ret.first->second.print(), id());
     }
-}
-
-void
-Type::
-fields(std::vector<std::string>& result) const
-{
-    result.reserve(result.size() + fields_.size());
-
-    for (const auto& field : fields_)
-        result.push_back(field.first);
 
-    if (parent_) parent_->fields(result);
+    invalidate();
 }
 
-std::vector<std::string>
+const std::vector<std::string>&
 Type::
 fields() const
 {
-    std::vector<std::string> result;
-    fields(result);
-
-    std::sort(result.begin(), result.end());
-    result.erase(std::unique(result.begin(), result.end()), result.end());
-
-    return result;
+    if (const Members* members = this->members())
+        return members->fieldNames;
+    return uncachedMembers().fieldNames;
 }
 
 bool
 Type::
 hasField(const std::string& field) const
 {
-    if (fields_.count(field)) return true;
+    if (const Members* members = this->members())
+        return members->fields.find(field) != nullptr;
+
+    if (findField(field)) return true;
     return parent_ ? parent_->hasField(field) : false;
 }
 
+Field*
+Type::
+findField(const std::string& field) const
+{
+    if (Registry::isSealed()) {
+        auto it = sealedFields_.find(field);
+        return it ? *it : nullptr;
+    }
+
+    auto it = fields_.find(field);
+    return it != fields_.end() ? const_cast<Field*>(&it->second) : nullptr;
+}
+
 Field&
 Type::
 field(const std::string& field)
 {
-    auto it = fields_.find(field);
-    if (it == fields_.end())
+    Field* result = findField(field);
+    if (!result)
         reflectError("<%s> doesn't have an immediate field <%s>", id_, field);
 
-    return it->second;
+    return *result;
 }
 
 const Field&
 Type::
 field(const std::string& field) const
 {
-    auto it = fields_.find(field);
-    if (it != fields_.end()) return it->second;
+    if (const Field* result = tryField(field)) return *result;
+    reflectError("<%s> doesn't have a field <%s>", id_, field);
+}
+
+const Field*
+Type::
+tryField(const std::string& field) const
+{
+    if (const Members* members = this->members()) {
+        auto result = members->fields.find(field);
+        return result ? *result : nullptr;
+    }
+
+    if (const Field* result = findField(field)) return result;
+    return parent_ ? parent_->tryField(field) : nullptr;
+}
+
+/** Tables are only cached once the type and all its parents are fully loaded
+    since they're still being modified until then. Returns null otherwise in
+    which case the caller should walk the hierarchy itself.
+ */
+const Type::Members*
+Type::
+members() const
+{
+    const Members* members = members_.load(std::memory_order_acquire);
+    if (members) return members;
+
+    for (const Type* type = this; type; type = type->parent_) {
+        if (!Registry::isLoaded(type)) return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(membersLock);
+
+    members = members_.load(std::memory_order_relaxed);
+    if (members) return members;
+
+    members = flatten();
+    memberTables_.emplace_back(members);
+    members_.store(members, std::memory_order_release);
+
+    return members;
+}
+
+// Only used to return the name lists of types that are still being loaded.
+// The tables are kept alive with the type since we hand out references and are
+// only rebuilt once the type or one of its parents is modified.
+const Type::Members&
+Type::
+uncachedMembers() const
+{
+    std::lock_guard<std::mutex> guard(membersLock);
+
+    if (!uncachedMembers_) {
+        uncachedMembers_ = flatten();
+        memberTables_.emplace_back(uncachedMembers_);
+    }
+
+    return *uncachedMembers_;
+}
+
+Type::Members*
+Type::
+flatten() const
+{
+    std::vector< std::pair<std::string, const Field*> > fields;
+    std::vector< std::pair<std::string, const Overloads*> > fns;
+    std::unordered_set<std::string> seenFields, seenFns;
+
+    // Walking from the child up means that the first member we see for a
+    // given name is the one that shadows the others.
+    for (const Type* type = this; type; type = type->parent_) {
+        for (const auto& field : type->fields_) {
+            if (seenFields.insert(field.first).second)
+                fields.emplace_back(field.first, &field.second);
+        }
+
+        for (const auto& fn : type->fns_) {
+            if (seenFns.insert(fn.first).second)
+                fns.emplace_back(fn.first, &fn.second);
+        }
+    }
+
+    std::unique_ptr<Members> members(new Members);
+
+    for (const Type* type = this; type; type = type->parent_)
+        members->display.push_back(type);
+    std::reverse(members->display.begin(), members->display.end());
+    members->depth = members->display.size() - 1;
+
+    members->fieldNames.reserve(fields.size());
+    for (const auto& field : fields) members->fieldNames.push_back(field.first);
+    std::sort(members->fieldNames.begin(), members->fieldNames.end());
+
+    members->functionNames.reserve(fns.size());
+    for (const auto& fn : fns) members->functionNames.push_back(fn.first);
+    std::sort(members->functionNames.begin(), members->functionNames.end());
+
+    std::vector< std::pair<std::string, const Overloads*> > converters;
+    for (const auto& fn : fns) {
+        std::string target;
+        if (isConverterName(fn.first, target))
+            converters.emplace_back(std::move(target), fn.second);
+    }
+
+    members->fields = PerfectHash<const Field*>(std::move(fields));
+    members->converters = PerfectHash<const Overloads*>(std::move(converters));
+    members->functions = PerfectHash<const Overloads*>(std::move(fns));
+
+    return members.release();
+}
+
+// Old tables are kept around until the type dies since readers may still be
+// using them.
+void
+Type::
+invalidate() const
+{
+    std::lock_guard<std::mutex> guard(membersLock);
 
-    if (!parent_)
-        reflectError("<%s> doesn't have a field <%s>", id_, field);
+    std::vector<const Type*> todo { this };
+    while (!todo.empty()) {
+        const Type* type = todo.back();
+        todo.pop_back();
 
-    return parent_->field(field);
+        type->members_.store(nullptr, std::memory_order_release);
+        type->uncachedMembers_ = nullptr;
+        todo.insert(todo.end(), type->children_.begin(), type->children_.end());
+    }
 }
 
 bool
 Type::
 isPointer() const
 {
-    return is("pointer");
+    return pointerKind_;
 }
 
 std::string
@@ -258,13 +526,64 @@ void
 Type::
 setPointer(std::string pointer, const Type* pointee)
 {
+    if (Registry::isSealed())
+        reflectError("can't make <%s> a pointer in a sealed registry", id());
     if (isPointer()) reflectError("<%s> is already a pointer", id());
 
     addTrait("pointer");
+    pointerKind_ = internPointerKind(pointer);
     pointer_ = std::move(pointer);
     pointee_ = pointee;
 }
 
+void
+Type::
+setNumberKind(NumberKind kind)
+{
+    if (Registry::isSealed())
+        reflectError("can't set number kind of <%s> in a sealed registry", id());
+
+    numberKind_ = kind;
+}
+
+void
+Type::
+setDestructor(Destructor destructor)
+{
+    if (Registry::isSealed())
+        reflectError("can't set destructor of <%s> in a sealed registry", id());
+
+    destructor_ = destructor;
+}
+
+void
+Type::
+seal()
+{
+    Traits::seal();
+
+    std::vector< std::pair<std::string, Field*> > fields;
+    fields.reserve(fields_.size());
+
+    for (auto& field : fields_) {
+        field.second.seal();
+        fields.emplace_back(field.first, &field.second);
+    }
+
+    std::vector< std::pair<std::string, Overloads*> > fns;
+    fns.reserve(fns_.size());
+
+    for (auto& fn : fns_) {
+        fn.second.seal();
+        fns.emplace_back(fn.first, &fn.second);
+    }
+
+    sealedFields_ = PerfectHash<Field*>(std::move(fields));
+    sealedFns_ = PerfectHash<Overloads*>(std::move(fns));
+
+    members();
+}
+
 Value
 Type::
 alloc() const
@@ -272,8 +591,31 @@ alloc() const
     return call<Value>("new");
 }
 
+/** Trivially copyable types also have trivial destructors so there's nothing
+    to call.
+ */
+void
+Type::
+destroyAt(void* mem) const
+{
+    if (isTriviallyCopyable()) return;
+
+    if (!destructor_) reflectError("<%s> doesn't have a destructor", id_);
+    destructor_(mem);
+}
+
 namespace  {
 
+template<typename Map>
+size_t mapFootprint(const Map& map)
+{
+    typedef typename Map::value_type Node;
+
+    // Buckets plus nodes which carry a next pointer and the cached hash.
+    return map.bucket_count() * sizeof(void*)
+        + map.size() * (sizeof(Node) + 2 * sizeof(void*));
+}
+
 std::vector<const Field*>
 sortedFields(const std::unordered_map<std::string, Field>& fields)
 {
@@ -292,6 +634,22 @@ sortedFields(const std::unordered_map<std::string, Field>& fields)
 
 } // namespace anonymous
 
+size_t
+Type::
+footprint() const
+{
+    size_t bytes = sizeof(*this) + id_.capacity() + pointer_.capacity();
+    bytes += mapFootprint(fields_) + mapFootprint(fns_);
+
+    for (const auto& fn : fns_)
+        bytes += fn.second.size() * sizeof(Function);
+
+    size_t trait = sizeof(std::string) + sizeof(Value) + 2 * sizeof(void*);
+    bytes += traits().size() * trait;
+
+    return bytes;
+}
+
 std::string
 Type::
 print(size_t indent) const
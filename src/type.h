@@ -16,7 +16,7 @@ namespace reflect {
 
 struct Type : public Traits
 {
-    explicit Type(std::string id);
+    explicit Type(std::string id, TypeIndex index = 0);
 
     Type(Type&&) = delete;
     Type(const Type&) = delete;
@@ -24,27 +24,38 @@ struct Type : public Traits
     Type& operator=(const Type&) = delete;
 
     const std::string& id() const { return id_; }
+    TypeIndex index() const { return index_; }
     const Type* parent() const { return parent_; }
-    void parent(const Type* parent) { parent_ = parent; }
+    void parent(const Type* parent);
 
     template<typename Fn>
     void addFunction(const std::string& name, Fn&& rawFn);
     void addFunction(const std::string& name, Function&& fn);
 
-    std::vector<std::string> functions() const;
+    const std::vector<std::string>& functions() const;
     bool hasFunction(const std::string& fn) const;
     Overloads& function(const std::string& fn);
     const Overloads& function(const std::string& fn) const;
 
+    // Returns null instead of failing if the function doesn't exist.
+    const Overloads* tryFunction(const std::string& fn) const;
+
     template<typename T>
     void addField(const std::string& name, size_t offset);
     void addField(const std::string& name, Field&& field);
 
-    std::vector<std::string> fields() const;
+    const std::vector<std::string>& fields() const;
     bool hasField(const std::string& field) const;
     Field& field(const std::string& field);
     const Field& field(const std::string& field) const;
 
+    // Returns null instead of failing if the field doesn't exist.
+    const Field* tryField(const std::string& field) const;
+
+    // Kind tag of the primitive number types; None for everything else.
+    NumberKind numberKind() const { return numberKind_; }
+    void setNumberKind(NumberKind kind);
+
     bool isPointer() const;
     std::string pointer() const;
     const Type* pointee() const;
@@ -69,28 +80,112 @@ struct Type : public Traits
     bool isCopiable() const;
     bool isMovable() const;
 
+    /** Types flagged by reflectPlumbing() whose copies, moves and assignments
+        can be done with a memcpy of size() bytes. size() and alignment()
+        return 0 if they weren't recorded.
+     */
+    bool isTriviallyCopyable() const;
+    size_t size() const;
+    size_t alignment() const;
+
     template<typename... Args>
     Value construct(Args&&... args) const;
     Value alloc() const;
 
+    /** Placement versions of construct() for memory managed by the caller
+        which must hold at least size() bytes aligned on alignment(). Objects
+        built this way must be destroyed through destroyAt() before their
+        memory is released.
+     */
+    template<typename... Args>
+    void constructAt(void* mem, Args&&... args) const;
+    void destroyAt(void* mem) const;
+
+    /** Destructor recorded by reflectPlumbing() for destroyAt(). It's kept out
+        of the functions and never inherited since the one of a parent would
+        skip the child's destructor and members.
+     */
+    typedef void (*Destructor)(void*);
+    bool hasDestructor() const { return destructor_; }
+    void setDestructor(Destructor destructor);
+
     template<typename Ret, typename... Args>
     Ret call(const std::string& fn, Args&&... args) const;
 
+    template<typename Ret, typename... Args>
+    void callBatch(const std::string& fn, Span<Ret> out, Args&&... args) const;
+
     std::string print(size_t indent = 0) const;
 
+    // Rough estimate of the heap memory held by the type's own metadata.
+    size_t footprint() const;
+
+    // Called by Registry::seal().
+    void seal();
+
 private:
 
-    void functions(std::vector<std::string>& result) const;
-    void fields(std::vector<std::string>& result) const;
+    // Own and inherited members flattened into a single table so that
+    // lookups cost the same regardless of the depth of the hierarchy.
+    struct Members
+    {
+        enum {
+            Known = 1 << 0,
+            Copiable = 1 << 1,
+            Movable = 1 << 2,
+            Trivial = 1 << 3,
+        };
+
+        Members() : depth(0), construction(0) {}
+
+        // Display of the parent chain: display[depth] is the type itself and
+        // display[0] is the root of its hierarchy.
+        size_t depth;
+        std::vector<const Type*> display;
+
+        // Lazily computed Copiable, Movable and Trivial flags.
+        mutable std::atomic<unsigned> construction;
+
+        PerfectHash<const Field*> fields;
+        PerfectHash<const Overloads*> functions;
+
+        // Conversion operators keyed by the id of their target type.
+        PerfectHash<const Overloads*> converters;
+
+        std::vector<std::string> fieldNames;
+        std::vector<std::string> functionNames;
+    };
+
+    const Members* members() const;
+    const Members& uncachedMembers() const;
+    Members* flatten() const;
+    void invalidate() const;
+    unsigned construction() const;
+
+    Overloads* findFunction(const std::string& fn) const;
+    Field* findField(const std::string& field) const;
 
     std::string id_;
+    TypeIndex index_;
     const Type* parent_;
 
     std::string pointer_;
+    size_t pointerKind_;
     const Type* pointee_;
 
+    NumberKind numberKind_;
+    Destructor destructor_;
+
     std::unordered_map<std::string, Field> fields_;
     std::unordered_map<std::string, Overloads> fns_;
+
+    PerfectHash<Field*> sealedFields_;
+    PerfectHash<Overloads*> sealedFns_;
+
+    mutable std::atomic<const Members*> members_;
+    mutable const Members* uncachedMembers_;
+    mutable std::vector< std::unique_ptr<const Members> > memberTables_;
+    mutable std::vector<const Type*> children_;
 };
 
 
@@ -38,6 +38,15 @@ construct(Args&&... args) const
     return call<Value>(id(), std::forward<Args>(args)...);
 }
 
+template<typename... Args>
+void
+Type::
+constructAt(void* mem, Args&&... args) const
+{
+    Argument ret(this, RefType::Copy, false);
+    function(id()).constructInto(mem, ret, std::forward<Args>(args)...);
+}
+
 template<typename Ret, typename... Args>
 Ret
 Type::
@@ -46,4 +55,12 @@ call(const std::string& fn, Args&&... args) const
     return function(fn).call<Ret>(std::forward<Args>(args)...);
 }
 
+template<typename Ret, typename... Args>
+void
+Type::
+callBatch(const std::string& fn, Span<Ret> out, Args&&... args) const
+{
+    function(fn).callBatch<Ret>(out, std::forward<Args>(args)...);
+}
+
 } // namespace reflect
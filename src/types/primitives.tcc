@@ -37,6 +37,7 @@ void reflectNumberImpl(Type* type_)
     reflectLimit(max);
 
     reflectTypeTrait(primitive);
+    type_->setNumberKind(numberKind<T_>());
 
     reflectCustom(operator+) (const T_& obj, T_ value) {
         return obj + value;
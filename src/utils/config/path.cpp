@@ -152,14 +152,14 @@ bool has(Value value, const Path& path, size_t index)
     if (value.type()->isPointer())
         return has(*value, path, index);
 
-    if (value.is("list")) {
+    if (value.is(traits::List)) {
         if (!path.isIndex(index)) return false;
         if (path.index(index) >= value.call<size_t>("size")) return false;
 
         return has(value[path.index(index)], path, index + 1);
     }
 
-    if (value.is("map")) {
+    if (value.is(traits::Map)) {
         if (value.type()->call<const Type*>("keyType") != type<std::string>())
             return false;
 
@@ -182,13 +182,13 @@ Value get(Value value, const Path& path, size_t index)
     if (value.type()->isPointer())
         return get(*value, path, index);
 
-    if (value.is("list")) {
+    if (value.is(traits::List)) {
         if (!value.isConst())
             value.call<void>("resize", path.index(index) + 1);
         return get(value[path.index(index)], path, index + 1);
     }
 
-    if (value.is("map"))
+    if (value.is(traits::Map))
         return get(value[path[index]], path, index + 1);
 
     return get(value.get<Value>(path[index]), path, index + 1);
@@ -18,12 +18,12 @@ void set(Value value, const Path& path, size_t index, Arg&& arg)
     if (value.type()->isPointer())
         details::set(*value, path, index, std::forward<Arg>(arg));
 
-    else if (value.is("list")) {
+    else if (value.is(traits::List)) {
         value.call<void>("resize", path.index(index) + 1);
         value[path.index(index)].assign(std::forward<Arg>(arg));
     }
 
-    else if (value.is("map"))
+    else if (value.is(traits::Map))
         value[path[index]].assign(std::forward<Arg>(arg));
 
     else value.set(path[index], std::forward<Arg>(arg));
@@ -13,8 +13,8 @@ namespace {
 
 std::string customParser(const Type* type)
 {
-    if (!type->is("json")) return "";
-    return type->getValue<json::Traits>("json").parser;
+    auto options = type->findValue<json::Traits>(traits::Json);
+    return options ? options->parser : "";
 }
 
 /******************************************************************************/
@@ -95,7 +95,7 @@ struct PointerParser : public Parser
     void init(const Type* type)
     {
         inner.init(type->pointee());
-        isSmartPtr = type->is("smartPtr");
+        isSmartPtr = type->is(traits::SmartPtr);
     }
 
     void parse(Reader& reader, Value& ptr) const
@@ -138,7 +138,7 @@ struct ArrayParser : public Parser
 {
     void init(const Type* type)
     {
-        inner.init(type->getValue<const Type*>("valueType"));
+        inner.init(type->getValue<const Type*>(traits::ValueType));
     }
 
     void parse(Reader& reader, Value& array) const
@@ -168,7 +168,7 @@ struct MapParser : public Parser
 {
     void init(const Type* type)
     {
-        inner.init(type->getValue<const Type*>("valueType"));
+        inner.init(type->getValue<const Type*>(traits::ValueType));
     }
 
     void parse(Reader& reader, Value& map) const
@@ -201,14 +201,13 @@ struct ObjectParser : public Parser
 {
     void init(const Type* type)
     {
-        for (std::string key : type->fields()) {
+        for (const std::string& key : type->fields()) {
             const Field& field = type->field(key);
 
             std::string alias = key;
-            if (field.is("json")) {
-                auto traits = field.getValue<Traits>("json");
-                if (traits.skip) continue;
-                if (!traits.alias.empty()) alias = traits.alias;
+            if (auto options = field.findValue<Traits>(traits::Json)) {
+                if (options->skip) continue;
+                if (!options->alias.empty()) alias = options->alias;
             }
 
             if (keys.count(alias))
@@ -333,28 +332,40 @@ struct ValueParser : public Parser
 
 const Parser* getParser(const Type* type)
 {
-    static std::unordered_map<const Type*, const Parser*> parsers;
+    static std::vector<const Parser*> parsers;
 
-    auto it = parsers.find(type);
-    if (it != parsers.end()) return it->second;
+    // Types that were never published through the registry all share index 0
+    // so they're keyed by address instead.
+    static std::unordered_map<const Type*, const Parser*> unindexed;
+
+    TypeIndex index = type->index();
+    if (!index) {
+        auto it = unindexed.find(type);
+        if (it != unindexed.end()) return it->second;
+    }
+    else if (index < parsers.size() && parsers[index]) return parsers[index];
 
     Parser* parser = nullptr;
 
-    if (type->is("bool")) parser = new BoolParser;
-    else if (type->is("float")) parser = new FloatParser;
-    else if (type->is("integer")) parser = new IntParser;
-    else if (type->is("string")) parser = new StringParser;
+    if (type->is(traits::Bool)) parser = new BoolParser;
+    else if (type->is(traits::Float)) parser = new FloatParser;
+    else if (type->is(traits::Integer)) parser = new IntParser;
+    else if (type->is(traits::String)) parser = new StringParser;
 
     else if (type->isPointer()) parser = new PointerParser;
-    else if (type->is("map")) parser = new MapParser;
-    else if (type->is("list")) parser = new ArrayParser;
+    else if (type->is(traits::Map)) parser = new MapParser;
+    else if (type->is(traits::List)) parser = new ArrayParser;
 
     else if (!customParser(type).empty()) parser = new CustomParser;
     else if (type == reflect::type<void>()) parser = new ValueParser;
 
     else parser = new ObjectParser;
 
-    parsers[type] = parser;
+    if (!index) unindexed[type] = parser;
+    else {
+        if (parsers.size() <= index) parsers.resize(index + 1, nullptr);
+        parsers[index] = parser;
+    }
     parser->init(type);
 
     return parser;
@@ -380,6 +391,12 @@ void parse(Reader& reader, Value& value)
     getParserLocked(value.type())->parse(reader, value);
 }
 
+void parse(Reader& reader, ValueRef value)
+{
+    Value borrowed = value.toValue();
+    parse(reader, borrowed);
+}
+
 } // namespace json
 } // namespace reflect
 
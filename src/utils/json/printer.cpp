@@ -49,8 +49,8 @@ namespace {
 
 std::string customPrinter(const Type* type)
 {
-    if (!type->is("json")) return "";
-    return type->getValue<json::Traits>("json").printer;
+    auto options = type->findValue<json::Traits>(traits::Json);
+    return options ? options->printer : "";
 }
 
 
@@ -63,8 +63,8 @@ struct Printer
     virtual ~Printer() {}
 
     virtual void init(const Type*) {}
-    virtual bool isEmpty(const Value&) const { return false; }
-    virtual void print(Writer& writer, const Value& value) const = 0;
+    virtual bool isEmpty(ValueRef) const { return false; }
+    virtual void print(Writer& writer, ValueRef value) const = 0;
 };
 
 const Printer* getPrinter(const Type* type);
@@ -92,48 +92,48 @@ struct TypePrinter
 
 struct BoolPrinter : public Printer
 {
-    void print(Writer& writer, const Value& value) const
+    void print(Writer& writer, ValueRef value) const
     {
-        printBool(writer, value);
+        printBool(writer, cast<bool>(value));
     }
 };
 
 struct IntPrinter : public Printer
 {
-    bool isEmpty(const Value& value) const
+    bool isEmpty(ValueRef value) const
     {
-        return cast<const int64_t&>(value) == 0;
+        return cast<int64_t>(value) == 0;
     }
 
-    void print(Writer& writer, const Value& value) const
+    void print(Writer& writer, ValueRef value) const
     {
-        printInt(writer, value);
+        printInt(writer, cast<int64_t>(value));
     }
 };
 
 struct FloatPrinter : public Printer
 {
-    bool isEmpty(const Value& value) const
+    bool isEmpty(ValueRef value) const
     {
-        return cast<const double&>(value) == 0;
+        return cast<double>(value) == 0;
     }
 
-    void print(Writer& writer, const Value& value) const
+    void print(Writer& writer, ValueRef value) const
     {
-        printFloat(writer, value);
+        printFloat(writer, cast<double>(value));
     }
 };
 
 struct StringPrinter : public Printer
 {
-    bool isEmpty(const Value& value) const
+    bool isEmpty(ValueRef value) const
     {
         return value.call<size_t>("size") == 0;
     }
 
-    void print(Writer& writer, const Value& value) const
+    void print(Writer& writer, ValueRef value) const
     {
-        printString(writer, value);
+        printString(writer, cast<const std::string&>(value));
     }
 };
 
@@ -146,19 +146,19 @@ struct PointerPrinter : public Printer
 {
     void init(const Type* type) { inner.init(type->pointee()); }
 
-    bool isEmpty(const Value& ptr) const
+    bool isEmpty(ValueRef ptr) const
     {
-        return !cast<bool>(ptr) || inner.printer->isEmpty(*ptr);
+        return !cast<bool>(ptr) || inner.printer->isEmpty(*ptr.toValue());
     }
 
-    void print(Writer& writer, const Value& ptr) const
+    void print(Writer& writer, ValueRef ptr) const
     {
         if (!cast<bool>(ptr)) {
             printNull(writer);
             return;
         }
 
-        Value pointee = *ptr;
+        Value pointee = *ptr.toValue();
         inner.printer->print(writer, pointee);
     }
 
@@ -175,15 +175,15 @@ struct ArrayPrinter : public Printer
 {
     void init(const Type* type)
     {
-        inner.init(type->getValue<const Type*>("valueType"));
+        inner.init(type->getValue<const Type*>(traits::ValueType));
     }
 
-    bool isEmpty(const Value& array) const
+    bool isEmpty(ValueRef array) const
     {
         return array.call<size_t>("size") == 0;
     }
 
-    void print(Writer& writer, const Value& array) const
+    void print(Writer& writer, ValueRef array) const
     {
         auto printFn = [&] (size_t i) {
             Value item = array.call<Value>("at", i);
@@ -205,15 +205,15 @@ struct MapPrinter : public Printer
 {
     void init(const Type* type)
     {
-        inner.init(type->getValue<const Type*>("valueType"));
+        inner.init(type->getValue<const Type*>(traits::ValueType));
     }
 
-    bool isEmpty(const Value& map) const
+    bool isEmpty(ValueRef map) const
     {
         return map.call<size_t>("size") == 0;
     }
 
-    void print(Writer& writer, const Value& map) const
+    void print(Writer& writer, ValueRef map) const
     {
         auto keys = map.call< std::vector<std::string> >("keys");
 
@@ -237,17 +237,16 @@ struct ObjectPrinter : public Printer
 {
     void init(const Type* type)
     {
-        for (std::string& key : type->fields()) {
+        for (const std::string& key : type->fields()) {
             const Field& field = type->field(key);
 
             std::string alias = key;
             bool isSkipEmpty = false;
 
-            if (field.is("json")) {
-                auto traits = field.getValue<Traits>("json");
-                if (traits.skip) continue;
-                if (!traits.alias.empty()) alias = traits.alias;
-                isSkipEmpty = traits.skipEmpty;
+            if (auto options = field.findValue<Traits>(traits::Json)) {
+                if (options->skip) continue;
+                if (!options->alias.empty()) alias = options->alias;
+                isSkipEmpty = options->skipEmpty;
             }
 
             if (fields.count(key))
@@ -265,7 +264,7 @@ struct ObjectPrinter : public Printer
         std::sort(sortedKeys.begin(), sortedKeys.end());
     }
 
-    void print(Writer& writer, const Value& obj) const
+    void print(Writer& writer, ValueRef obj) const
     {
         auto getField = [&] (const std::string& alias) {
             auto keyIt = keys.find(alias);
@@ -287,15 +286,13 @@ struct ObjectPrinter : public Printer
 
             auto it = getField(alias);
 
-            Value field = obj.field(it->first);
-            return it->second.printer->isEmpty(field);
+            return it->second.printer->isEmpty(obj.field(it->first));
         };
 
         auto printFn = [&] (const std::string& alias) {
             auto it = getField(alias);
 
-            Value field = obj.field(it->first);
-            it->second.printer->print(writer, field);
+            it->second.printer->print(writer, obj.field(it->first));
         };
 
         printObject(writer, sortedKeys, printFn, skipFn);
@@ -324,9 +321,9 @@ struct CustomPrinter : public Printer
         printer = &type->function(name).get<void(Value, Writer&)>();
     }
 
-    void print(Writer& writer, const Value& value) const
+    void print(Writer& writer, ValueRef value) const
     {
-        printer->call<void>(value, writer);
+        printer->call<void>(value.toValue(), writer);
     }
 
 private:
@@ -340,21 +337,29 @@ private:
 
 const Printer* getPrinter(const Type* type)
 {
-    static std::unordered_map<const Type*, const Printer*> printers;
+    static std::vector<const Printer*> printers;
 
-    auto it = printers.find(type);
-    if (it != printers.end()) return it->second;
+    // Types that were never published through the registry all share index 0
+    // so they're keyed by address instead.
+    static std::unordered_map<const Type*, const Printer*> unindexed;
+
+    TypeIndex index = type->index();
+    if (!index) {
+        auto it = unindexed.find(type);
+        if (it != unindexed.end()) return it->second;
+    }
+    else if (index < printers.size() && printers[index]) return printers[index];
 
     Printer* printer = nullptr;
 
-    if (type->is("bool")) printer = new BoolPrinter;
-    else if (type->is("integer")) printer = new IntPrinter;
-    else if (type->is("float")) printer = new FloatPrinter;
-    else if (type->is("string")) printer = new StringPrinter;
+    if (type->is(traits::Bool)) printer = new BoolPrinter;
+    else if (type->is(traits::Integer)) printer = new IntPrinter;
+    else if (type->is(traits::Float)) printer = new FloatPrinter;
+    else if (type->is(traits::String)) printer = new StringPrinter;
 
     else if (type->isPointer()) printer = new PointerPrinter;
-    else if (type->is("map")) printer = new MapPrinter;
-    else if (type->is("list")) printer = new ArrayPrinter;
+    else if (type->is(traits::Map)) printer = new MapPrinter;
+    else if (type->is(traits::List)) printer = new ArrayPrinter;
 
     else if (!customPrinter(type).empty()) printer = new CustomPrinter;
     else if (type == reflect::type<void>())
@@ -362,7 +367,11 @@ const Printer* getPrinter(const Type* type)
 
     else printer = new ObjectPrinter;
 
-    printers[type] = printer;
+    if (!index) unindexed[type] = printer;
+    else {
+        if (printers.size() <= index) printers.resize(index + 1, nullptr);
+        printers[index] = printer;
+    }
     printer->init(type);
 
     return printer;
@@ -384,6 +393,11 @@ const Printer* getPrinterLocked(const Type* type)
 /******************************************************************************/
 
 void print(Writer& writer, const Value& value)
+{
+    print(writer, ValueRef(value));
+}
+
+void print(Writer& writer, ValueRef value)
 {
     getPrinterLocked(value.type())->print(writer, value);
 }
@@ -41,6 +41,7 @@ void printArray(Writer& writer, size_t n, const PrintFn& printFn, const SkipFn&
 /******************************************************************************/
 
 void print(Writer& writer, const Value& value);
+void print(Writer& writer, ValueRef value);
 template<typename T> Error print(Writer& writer, const T& value);
 template<typename T> Error print(std::ostream& stream, const T& value);
 template<typename T> std::pair<std::string, Error> print(const T& value);
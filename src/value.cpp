@@ -7,6 +7,8 @@
 
 #include "reflect.h"
 
+#include <cstring>
+
 namespace reflect {
 
 
@@ -15,7 +17,7 @@ namespace reflect {
 /******************************************************************************/
 
 Value::
-Value() : value_(nullptr) {}
+Value() : value_(nullptr), storage(nullptr) {}
 
 // This is required to avoid trigerring the templated constructor for Value when
 // trying to copy non-const Values. This is common in data-structures like
@@ -26,14 +28,20 @@ Value(Value& other) :
     arg(other.arg),
     value_(other.value_),
     storage(other.storage)
-{}
+{
+    if (storage) storage->acquire();
+    copyInline(other);
+}
 
 Value::
 Value(const Value& other) :
     arg(other.arg),
     value_(other.value_),
     storage(other.storage)
-{}
+{
+    if (storage) storage->acquire();
+    copyInline(other);
+}
 
 Value&
 Value::
@@ -41,9 +49,13 @@ operator=(const Value& other)
 {
     if (this == &other) return *this;
 
+    if (other.storage) other.storage->acquire();
+    if (storage) storage->release();
+
     arg = other.arg;
     value_ = other.value_;
     storage = other.storage;
+    copyInline(other);
 
     return *this;
 }
@@ -51,9 +63,12 @@ operator=(const Value& other)
 Value::
 Value(Value&& other) :
     arg(std::move(other.arg)),
-    value_(std::move(other.value_)),
-    storage(std::move(other.storage))
-{}
+    value_(other.value_),
+    storage(other.storage)
+{
+    other.storage = nullptr;
+    copyInline(other);
+}
 
 Value&
 Value::
@@ -61,13 +76,158 @@ operator=(Value&& other)
 {
     if (this == &other) return *this;
 
+    if (storage) storage->release();
+
     arg = std::move(other.arg);
-    value_ = std::move(other.value_);
-    storage = std::move(other.storage);
+    value_ = other.value_;
+    storage = other.storage;
+    other.storage = nullptr;
+    copyInline(other);
 
     return *this;
 }
 
+Value::
+~Value()
+{
+    if (storage) storage->release();
+}
+
+/** Inline values are trivially copyable scalars so copies and moves of the
+    Value just copy the bytes over. The source is never modified which keeps
+    copying a const Value thread-safe.
+ */
+void
+Value::
+copyInline(const Value& other)
+{
+    if (!other.isInline()) return;
+
+    std::memcpy(&inline_, &other.inline_, sizeof(inline_));
+    value_ = &inline_;
+}
+
+namespace {
+
+// Control block followed by the raw bytes of a trivially copyable object.
+// Such objects have trivial destructors so there's nothing to run on release.
+struct ValueRawBlock : public ValueStorage
+{
+    static ValueRawBlock* make(size_t size, size_t align)
+    {
+        size_t bytes = offset(align) + size;
+
+        void* block = ValueArena::alloc(bytes, align);
+        if (block) return new (block) ValueRawBlock(&ValueRawBlock::freeArena);
+
+        return new (::operator new(bytes)) ValueRawBlock(&ValueRawBlock::free);
+    }
+
+    static size_t offset(size_t align)
+    {
+        return (sizeof(ValueRawBlock) + align - 1) & ~(align - 1);
+    }
+
+private:
+    explicit ValueRawBlock(void (*destroy)(ValueStorage*)) :
+        ValueStorage(destroy)
+    {}
+
+    static void free(ValueStorage* self)
+    {
+        static_cast<ValueRawBlock*>(self)->~ValueRawBlock();
+        ::operator delete(self);
+    }
+
+    static void freeArena(ValueStorage* self)
+    {
+        static_cast<ValueRawBlock*>(self)->~ValueRawBlock();
+        ValueArena::free(self);
+    }
+};
+
+} // namespace anonymous
+
+/** The copy may be shared so it's never inline. Anything that's over-aligned
+    goes through the regular copy constructor since operator new makes no
+    guarantees for it.
+ */
+Value
+Value::
+copyTrivial(const Type* type, const void* value)
+{
+    size_t size = type->size();
+    size_t align = type->alignment();
+
+    if (align > alignof(std::max_align_t)) {
+        Value source;
+        source.arg = Argument(type, RefType::LValue, true);
+        source.value_ = const_cast<void*>(value);
+        return type->construct(source);
+    }
+
+    ValueRawBlock* block = ValueRawBlock::make(size, align);
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(block);
+
+    Value result;
+    result.arg = Argument(type, RefType::LValue, false);
+    result.storage = block;
+    result.value_ = bytes + ValueRawBlock::offset(align);
+
+    std::memcpy(result.value_, value, size);
+    return result;
+}
+
+/** Inline scalars are trivially copyable and never over-aligned so their bytes
+    can be moved as is.
+ */
+void
+Value::
+share()
+{
+    if (!isInline()) return;
+
+    size_t size = type()->size();
+    size_t align = type()->alignment();
+
+    ValueRawBlock* block = ValueRawBlock::make(size, align);
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(block);
+
+    storage = block;
+    value_ = bytes + ValueRawBlock::offset(align);
+    std::memcpy(value_, &inline_, size);
+}
+
+bool
+Value::
+assignNumber(NumberRef value) const
+{
+    if (isConst() || value.kind == NumberKind::None) return false;
+    return numberConvert(value, type()->numberKind(), value_);
+}
+
+bool
+Value::
+assignNumber(NumberOp op, NumberRef value) const
+{
+    if (isConst() || value.kind == NumberKind::None) return false;
+
+    Value result;
+    if (!numberOp(op, numberRef(*this), value, result)) return false;
+    return numberConvert(numberRef(result), type()->numberKind(), value_);
+}
+
+bool
+Value::
+assignTrivial(const Value& other) const
+{
+    if (isConst() || !type()->isTriviallyCopyable()) return false;
+    if (!other.type()->isChildOf(type())) return false;
+
+    std::memmove(value_, other.value_, type()->size());
+    return true;
+}
+
 const std::string&
 Value::
 typeId() const
@@ -82,21 +242,43 @@ is(const std::string& trait) const
     return type()->is(trait);
 }
 
+bool
+Value::
+is(TraitKey trait) const
+{
+    return type()->is(trait);
+}
+
 
 Value
 Value::
 copy() const
 {
-    if (!type()->isCopiable())
-        reflectError("<%s> is not copiable", type()->id());
+    return copy(type());
+}
+
+Value
+Value::
+copy(const Type* target) const
+{
+    if (target->isTriviallyCopyable()) return copyTrivial(target, value_);
+
+    if (!target->isCopiable())
+        reflectError("<%s> is not copiable", target->id());
 
-    return type()->construct(*this);
+    return target->construct(*this);
 }
 
 Value
 Value::
 move()
 {
+    if (type()->isTriviallyCopyable()) {
+        Value result = copyTrivial(type(), value_);
+        *this = Value();
+        return result;
+    }
+
     if (!type()->isMovable())
         reflectError("<%s> is not movable", type()->id());
 
@@ -105,6 +287,32 @@ move()
     return arg.type()->construct(arg);
 }
 
+Value
+Value::
+borrow() const
+{
+    Value result;
+    result.arg = arg;
+    result.value_ = value_;
+    return result;
+}
+
+Status
+Value::
+tryField(const std::string& field, Value& out) const
+{
+    const Field* f = type()->tryField(field);
+    if (!f) return Status(StatusCode::NoField, type());
+
+    bool isConst = f->argument().isConst() || this->isConst();
+
+    out = Value();
+    out.arg = Argument(f->type(), RefType::LValue, isConst);
+    out.value_ = static_cast<uint8_t*>(value_) + f->offset();
+
+    return Status();
+}
+
 Value
 Value::
 toConst() const
@@ -135,6 +343,9 @@ operator!() const
 Value::
 operator bool() const
 {
+    NumberRef number = numberRef(*this);
+    if (number.kind != NumberKind::None) return numberToBool(number);
+
     return call<bool>("operator bool()");
 }
 
@@ -61,6 +61,38 @@ struct CleanValue
         return call<bool>(#op, std::forward<Arg>(arg)); \
     }
 
+// Numbers are handled directly through their kind tag when possible.
+#define reflectValueOpNumber(op, numberOpTag)                           \
+    template<typename Arg>                                              \
+    Value op(Arg&& arg) const                                           \
+    {                                                                   \
+        Value result;                                                   \
+        NumberOp tag = NumberOp::numberOpTag;                           \
+        if (numberOp(tag, numberRef(*this), numberRef(arg), result))    \
+            return result;                                              \
+        return call<Value>(#op, std::forward<Arg>(arg));                \
+    }
+
+#define reflectValueOpNumberAssign(op, numberOpTag)                     \
+    template<typename Arg>                                              \
+    Value op(Arg&& arg) const                                           \
+    {                                                                   \
+        if (assignNumber(NumberOp::numberOpTag, numberRef(arg)))        \
+            return borrow();                                            \
+        return call<Value>(#op, std::forward<Arg>(arg));                \
+    }
+
+#define reflectValueOpNumberBool(op, numberOpTag)                       \
+    template<typename Arg>                                              \
+    bool op(Arg&& arg) const                                            \
+    {                                                                   \
+        Value result;                                                   \
+        NumberOp tag = NumberOp::numberOpTag;                           \
+        if (numberOp(tag, numberRef(*this), numberRef(arg), result))    \
+            return numberToBool(numberRef(result));                     \
+        return call<bool>(#op, std::forward<Arg>(arg));                 \
+    }
+
 #define reflectValueOpNary(op)                                  \
     template<typename... Args>                                  \
     Value op(Args&&... args) const                              \
@@ -69,6 +101,117 @@ struct CleanValue
     }
 
 
+/******************************************************************************/
+/* VALUE STORAGE                                                              */
+/******************************************************************************/
+
+/** Single threaded programs can opt out of the atomic refcounting of stored
+    Values. Must be set identically for the library and all its users.
+ */
+#ifndef REFLECT_NONATOMIC_VALUES
+#   define REFLECT_NONATOMIC_VALUES 0
+#endif
+
+enum { NonAtomicValues = REFLECT_NONATOMIC_VALUES };
+
+/** Intrusive control block which precedes heap-stored values in the same
+    allocation. See ValueBlock.
+ */
+struct ValueStorage
+{
+    typedef std::conditional<NonAtomicValues,
+            size_t, std::atomic<size_t> >::type RefCount;
+
+    explicit ValueStorage(void (*destroy)(ValueStorage*)) :
+        refs(1), destroy(destroy)
+    {}
+
+    void acquire() { acquire(refs); }
+    void release() { if (release(refs)) destroy(this); }
+
+private:
+    static void acquire(size_t& refs) { refs++; }
+    static void acquire(std::atomic<size_t>& refs)
+    {
+        refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static bool release(size_t& refs) { return !--refs; }
+    static bool release(std::atomic<size_t>& refs)
+    {
+        return refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    RefCount refs;
+    void (*destroy)(ValueStorage*);
+};
+
+template<typename T>
+struct ValueBlock : public ValueStorage
+{
+    // Allocated from the current ValueArena if there's one.
+    template<typename... Args>
+    static ValueBlock* make(Args&&... args)
+    {
+        size_t size = sizeof(ValueBlock);
+        void* block = ValueArena::alloc(size, alignof(ValueBlock));
+        if (!block)
+            return new ValueBlock(&free, std::forward<Args>(args)...);
+
+        return new (block) ValueBlock(&freeArena, std::forward<Args>(args)...);
+    }
+
+    T object;
+
+private:
+    template<typename... Args>
+    explicit ValueBlock(void (*destroy)(ValueStorage*), Args&&... args) :
+        ValueStorage(destroy),
+        object(std::forward<Args>(args)...)
+    {}
+
+    static void free(ValueStorage* self)
+    {
+        delete static_cast<ValueBlock*>(self);
+    }
+
+    static void freeArena(ValueStorage* self)
+    {
+        static_cast<ValueBlock*>(self)->~ValueBlock();
+        ValueArena::free(self);
+    }
+};
+
+
+/******************************************************************************/
+/* INLINE VALUE                                                               */
+/******************************************************************************/
+
+typedef std::aligned_storage<2 * sizeof(void*), alignof(void*)>::type
+    ValueInlineStorage;
+
+/** Scalars (primitives, enums and pointers) can be stored within the Value
+    itself instead of on the heap. Copies of a Value must keep referring to the
+    same object so this is only done for the temporaries that the library holds
+    on to for the duration of a call: arguments passed as rvalues and the
+    results of ValueFunction. Such a temporary is moved to shared storage if it
+    ever gets handed out as a Value (see Value::share) which means that any
+    Value seen outside of a call is never inline.
+ */
+template<typename T>
+struct IsInlineValue
+{
+    typedef typename std::decay<T>::type CleanT;
+
+    static constexpr bool value =
+        std::is_scalar<CleanT>::value &&
+        sizeof(CleanT) <= sizeof(ValueInlineStorage) &&
+        alignof(CleanT) <= alignof(ValueInlineStorage);
+
+    typedef std::integral_constant<bool, value> type;
+};
+
+
 /******************************************************************************/
 /* VALUE                                                                      */
 /******************************************************************************/
@@ -87,17 +230,20 @@ struct Value
     Value(Value&& other);
     Value& operator=(Value&& other);
 
+    ~Value();
+
     void* value() const { return value_; }
     const Type* type() const { return arg.type(); }
     const std::string& typeId() const;
     RefType refType() const { return arg.refType(); }
     bool isConst() const { return arg.isConst(); }
     bool isVoid() const { return arg.isVoid(); }
-    bool isStored() const { return !!storage; }
+    bool isStored() const { return isInline() || storage; }
 
     const Argument& argument() const { return arg; }
 
     bool is(const std::string& trait) const;
+    bool is(TraitKey trait) const;
 
     // Get a reference to the value without any type checks.
     template<typename T> T& as();
@@ -105,12 +251,28 @@ struct Value
 
     Value toConst() const;
     Value rvalue() const;
+
+    // Refers to the same object without taking ownership of it which means
+    // that the result must not outlive this Value.
+    Value borrow() const;
     Value copy() const;
     Value move();
 
+    // Copy of the value as one of its parent types which slices off the rest.
+    Value copy(const Type* target) const;
+
     template<typename Ret, typename... Args>
     Ret call(const std::string& fn, Args&&... args) const;
 
+    // Assigns the result of the function to out. See Function::callInto.
+    template<typename Ret, typename... Args>
+    void callInto(Ret& out, const std::string& fn, Args&&... args) const;
+
+    // Non-throwing versions of callInto and field. See Overloads::tryCall.
+    template<typename Ret, typename... Args>
+    Status tryCall(Ret& out, const std::string& fn, Args&&... args) const;
+    Status tryField(const std::string& field, Value& out) const;
+
     template<typename Ret = Value>
     Ret field(const std::string& field) const;
 
@@ -121,14 +283,14 @@ struct Value
     template<typename Ret>
     Ret convert(const Type* target) const;
 
-    reflectValueOpBinary(operator+=)
-    reflectValueOpBinary(operator-=)
-    reflectValueOpBinary(operator*=)
-    reflectValueOpBinary(operator/=)
-    reflectValueOpBinary(operator%=)
-    reflectValueOpBinary(operator&=)
-    reflectValueOpBinary(operator|=)
-    reflectValueOpBinary(operator^=)
+    reflectValueOpNumberAssign(operator+=, Add)
+    reflectValueOpNumberAssign(operator-=, Sub)
+    reflectValueOpNumberAssign(operator*=, Mul)
+    reflectValueOpNumberAssign(operator/=, Div)
+    reflectValueOpNumberAssign(operator%=, Mod)
+    reflectValueOpNumberAssign(operator&=, And)
+    reflectValueOpNumberAssign(operator|=, Or)
+    reflectValueOpNumberAssign(operator^=, Xor)
     reflectValueOpBinary(operator<<=)
     reflectValueOpBinary(operator>>=)
 
@@ -137,15 +299,15 @@ struct Value
     reflectValueOpUnary (operator--)
     reflectValueOpBinary(operator--)
 
-    reflectValueOpBinary(operator+)
-    reflectValueOpBinary(operator-)
-    reflectValueOpBinary(operator*)
-    reflectValueOpBinary(operator/)
-    reflectValueOpBinary(operator%)
+    reflectValueOpNumber(operator+, Add)
+    reflectValueOpNumber(operator-, Sub)
+    reflectValueOpNumber(operator*, Mul)
+    reflectValueOpNumber(operator/, Div)
+    reflectValueOpNumber(operator%, Mod)
     reflectValueOpUnary (operator~)
-    reflectValueOpBinary(operator&)
-    reflectValueOpBinary(operator|)
-    reflectValueOpBinary(operator^)
+    reflectValueOpNumber(operator&, And)
+    reflectValueOpNumber(operator|, Or)
+    reflectValueOpNumber(operator^, Xor)
     reflectValueOpBinary(operator<<)
     reflectValueOpBinary(operator>>)
 
@@ -153,12 +315,12 @@ struct Value
     reflectValueOpBool(operator&&)
     reflectValueOpBool(operator||)
 
-    reflectValueOpBool(operator==)
-    reflectValueOpBool(operator!=)
-    reflectValueOpBool(operator<)
-    reflectValueOpBool(operator>)
-    reflectValueOpBool(operator<=)
-    reflectValueOpBool(operator>=)
+    reflectValueOpNumberBool(operator==, Eq)
+    reflectValueOpNumberBool(operator!=, Ne)
+    reflectValueOpNumberBool(operator<, Lt)
+    reflectValueOpNumberBool(operator>, Gt)
+    reflectValueOpNumberBool(operator<=, Le)
+    reflectValueOpNumberBool(operator>=, Ge)
 
     reflectValueOpNary  (operator())
     reflectValueOpBinary(operator[])
@@ -167,10 +329,43 @@ struct Value
     explicit operator bool() const;
 
 private:
+    friend struct ValueRef;
+    friend struct Function;
+    template<typename, typename> friend struct Cast;
+    template<typename, typename> friend struct ValueFunctionImpl;
+
+    // Inline is only true for temporaries. See IsInlineValue.
+    template<typename T, typename Inline>
+    Value(T&& value, Inline);
+
+    template<typename T> static Value temporary(T&& value);
+    template<typename T> static Value temporary(T&& value, std::true_type);
+    template<typename T> static Value temporary(T&& value, std::false_type);
+
+    // Moves an inline temporary to shared storage before it's handed out.
+    void share();
+
+    template<typename T> void store(T&& value, std::true_type);
+    template<typename T> void store(T&& value, std::false_type);
+
+    template<typename Arg> void assign(Arg&& arg, std::true_type) const;
+    template<typename Arg> void assign(Arg&& arg, std::false_type) const;
+
+    bool assignNumber(NumberRef value) const;
+    bool assignNumber(NumberOp op, NumberRef value) const;
+
+    // memcpy based fast paths for trivially copyable types.
+    static Value copyTrivial(const Type* type, const void* value);
+    bool assignTrivial(const Value& other) const;
+
+    bool isInline() const { return value_ == &inline_; }
+    void copyInline(const Value& other);
 
     Argument arg;
+
     void* value_;
-    std::shared_ptr<void> storage;
+    ValueStorage* storage;
+    ValueInlineStorage inline_;
 };
 
 
@@ -24,36 +24,31 @@ struct IsMovable
     typedef std::integral_constant<bool, value> type;
 };
 
-template<typename T>
-struct ValueDestructor
-{
-    void operator() (void* ptr) const
-    {
-        delete static_cast<T*>(ptr);
-    }
-};
-
 
 /******************************************************************************/
 /* VALUE                                                                      */
 /******************************************************************************/
 
+// Control block and object share a single allocation.
 template<typename T, typename Meh>
-void* store(T&& value, std::true_type, Meh)
+ValueBlock<typename std::decay<T>::type>*
+store(T&& value, std::true_type, Meh)
 {
     typedef typename std::decay<T>::type CleanT;
-    return new CleanT(std::move(value));
+    return ValueBlock<CleanT>::make(std::move(value));
 }
 
 template<typename T>
-void* store(T&& value, std::false_type, std::true_type)
+ValueBlock<typename std::decay<T>::type>*
+store(T&& value, std::false_type, std::true_type)
 {
     typedef typename std::decay<T>::type CleanT;
-    return new CleanT(value);
+    return ValueBlock<CleanT>::make(value);
 }
 
 template<typename T, typename... Rest>
-void* store(Rest&&...)
+ValueBlock<typename std::decay<T>::type>*
+store(Rest&&...)
 {
     reflectError(
             "<%s> cannot be stored (no move/copy constructor)",
@@ -62,22 +57,70 @@ void* store(Rest&&...)
 
 template<typename T>
 Value::
-Value(T&& value) :
+Value(T&& value) : Value(std::forward<T>(value), std::false_type()) {}
+
+template<typename T, typename Inline>
+Value::
+Value(T&& value, Inline) :
     arg(Argument::make(std::forward<T>(value))),
-    value_((void*)&value) // cast-away any const
+    value_((void*)&value), // cast-away any const
+    storage(nullptr)
 {
     if (refType() != RefType::RValue) return;
 
+    store(std::forward<T>(value), Inline());
+
+    // We now own the value so we're now l-ref-ing our internal storage.
+    arg = Argument(arg.type(), RefType::LValue, false);
+}
+
+template<typename T>
+Value
+Value::
+temporary(T&& value)
+{
+    return temporary(std::forward<T>(value), typename IsInlineValue<T>::type());
+}
+
+template<typename T>
+Value
+Value::
+temporary(T&& value, std::true_type)
+{
+    return Value(std::forward<T>(value), std::true_type());
+}
+
+// Also keeps Values from being wrapped in another Value.
+template<typename T>
+Value
+Value::
+temporary(T&& value, std::false_type)
+{
+    return Value(std::forward<T>(value));
+}
+
+template<typename T>
+void
+Value::
+store(T&& value, std::true_type)
+{
+    typedef typename std::decay<T>::type CleanT;
+    value_ = new (&inline_) CleanT(value);
+}
+
+template<typename T>
+void
+Value::
+store(T&& value, std::false_type)
+{
     typedef typename std::decay<T>::type CleanT;
 
-    value_ = store<T>(std::forward<T>(value),
+    auto* block = reflect::store<T>(std::forward<T>(value),
             typename IsMovable<T>::type(),
             typename std::is_copy_constructible<CleanT>::type());
 
-    storage.reset(value_, ValueDestructor<CleanT>());
-
-    // We now own the value so we're now l-ref-ing our internal storage.
-    arg = Argument(arg.type(), RefType::LValue, false);
+    storage = block;
+    value_ = &block->object;
 }
 
 template<typename T>
@@ -116,6 +159,26 @@ call(const std::string& fn, Args&&... args) const
     return f.call<Ret>(*this, std::forward<Args>(args)...);
 }
 
+template<typename Ret, typename... Args>
+void
+Value::
+callInto(Ret& out, const std::string& fn, Args&&... args) const
+{
+    const auto& f = type()->function(fn);
+    f.callInto(out, *this, std::forward<Args>(args)...);
+}
+
+template<typename Ret, typename... Args>
+Status
+Value::
+tryCall(Ret& out, const std::string& fn, Args&&... args) const
+{
+    const Overloads* f = type()->tryFunction(fn);
+    if (!f) return Status(StatusCode::NoFunction, type());
+
+    return f->tryCall(out, *this, std::forward<Args>(args)...);
+}
+
 template<typename Ret>
 Ret
 Value::
@@ -135,6 +198,26 @@ template<typename Arg>
 void
 Value::
 assign(Arg&& arg) const
+{
+    if (assignNumber(numberRef(arg))) return;
+
+    typedef typename std::decay<Arg>::type CleanArg;
+    assign(std::forward<Arg>(arg), typename std::is_same<CleanArg, Value>::type());
+}
+
+template<typename Arg>
+void
+Value::
+assign(Arg&& arg, std::true_type) const
+{
+    if (assignTrivial(arg)) return;
+    call<void>("operator=", std::forward<Arg>(arg));
+}
+
+template<typename Arg>
+void
+Value::
+assign(Arg&& arg, std::false_type) const
 {
     call<void>("operator=", std::forward<Arg>(arg));
 }
@@ -148,4 +231,14 @@ convert(const Type* target) const
     return type()->converter(target).call<Ret>(*this);
 }
 
+
+/******************************************************************************/
+/* NUMBER REF                                                                 */
+/******************************************************************************/
+
+inline NumberRef numberRef(const Value& value)
+{
+    return { value.type()->numberKind(), value.value() };
+}
+
 } // reflect
@@ -0,0 +1,144 @@
+/* value_arena.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Value arena implementation.
+*/
+
+#include "reflect.h"
+
+#include <cstdio>
+
+namespace reflect {
+
+namespace {
+
+thread_local ValueArena* currentValueArena = nullptr;
+
+// Blocks are prefixed by the arena that owns them when checks are enabled so
+// that free() can find it.
+enum { ValueArenaHeader = CheckValueArena ? size_t(ValueArena::Alignment) : 0 };
+
+size_t valueArenaBlockSize(size_t size)
+{
+    size_t align = ValueArena::Alignment;
+    return (size + ValueArenaHeader + align - 1) & ~(align - 1);
+}
+
+// Errors detected by the destructor can't be thrown so they're always fatal.
+void valueArenaAbort(int line, const std::string& msg)
+{
+    printf("%s:%d: %s\n", __FILE__, line, msg.c_str());
+    abort();
+}
+
+} // namespace anonymous
+
+
+/******************************************************************************/
+/* VALUE ARENA                                                                */
+/******************************************************************************/
+
+ValueArena::
+ValueArena() :
+    prev(currentValueArena),
+    chunks(nullptr), pos(nullptr), end(nullptr),
+    memory_(0), used_(0), live_(0)
+{
+    currentValueArena = this;
+}
+
+ValueArena::
+~ValueArena()
+{
+    while (chunks) {
+        void* next = *static_cast<void**>(chunks);
+        std::free(chunks);
+        chunks = next;
+    }
+
+    if (currentValueArena != this) {
+        valueArenaAbort(__LINE__,
+                "value arenas must be destroyed in reverse order");
+    }
+    currentValueArena = prev;
+
+    if (CheckValueArena && live_) {
+        valueArenaAbort(__LINE__,
+                errorFormat("%lu values escaped their value arena", live_));
+    }
+}
+
+ValueArena*
+ValueArena::
+current()
+{
+    return currentValueArena;
+}
+
+ValueArena::Suspend::
+Suspend() : arena(currentValueArena)
+{
+    currentValueArena = nullptr;
+}
+
+ValueArena::Suspend::
+~Suspend()
+{
+    currentValueArena = arena;
+}
+
+void*
+ValueArena::
+bump(size_t size)
+{
+    if (size_t(end - pos) < size) {
+        void* chunk = std::malloc(ChunkSize);
+        if (!chunk) reflectError("unable to allocate value arena chunk");
+
+        *static_cast<void**>(chunk) = chunks;
+        chunks = chunk;
+        memory_ += ChunkSize;
+
+        pos = static_cast<uint8_t*>(chunk) + Alignment;
+        end = static_cast<uint8_t*>(chunk) + ChunkSize;
+    }
+
+    void* ptr = pos;
+    pos += size;
+    return ptr;
+}
+
+void*
+ValueArena::
+alloc(size_t size, size_t align)
+{
+    ValueArena* arena = currentValueArena;
+    if (!arena || size > MaxBlock || align > Alignment) return nullptr;
+
+    size = valueArenaBlockSize(size);
+    arena->used_ += size;
+
+    uint8_t* block = static_cast<uint8_t*>(arena->bump(size));
+    if (!CheckValueArena) return block;
+
+    arena->live_++;
+    *reinterpret_cast<ValueArena**>(block) = arena;
+    return block + ValueArenaHeader;
+}
+
+/** Memory is only reclaimed when the arena is destroyed so there's nothing to
+    do beyond keeping track of the live blocks.
+ */
+void
+ValueArena::
+free(void* ptr)
+{
+    if (!CheckValueArena || !ptr) return;
+
+    uint8_t* block = static_cast<uint8_t*>(ptr) - ValueArenaHeader;
+    ValueArena* arena = *reinterpret_cast<ValueArena**>(block);
+    arena->live_--;
+}
+
+} // reflect
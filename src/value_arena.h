@@ -0,0 +1,101 @@
+/* value_arena.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Scoped bump allocator for the storage of Values.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* VALUE ARENA                                                                */
+/******************************************************************************/
+
+/** Escaping Values are detected when the arena is destroyed which then aborts
+    since destructors can't report errors. Defaults to on unless NDEBUG is
+    defined.
+ */
+#ifndef REFLECT_CHECK_VALUE_ARENA
+#   ifdef NDEBUG
+#       define REFLECT_CHECK_VALUE_ARENA 0
+#   else
+#       define REFLECT_CHECK_VALUE_ARENA 1
+#   endif
+#endif
+
+enum { CheckValueArena = REFLECT_CHECK_VALUE_ARENA };
+
+/** RAII scope which, while alive, serves the storage of all the Values stored
+    on the current thread from a bump allocator. Releasing a Value doesn't
+    free anything and all the memory is returned at once when the scope ends.
+    Meant to wrap a unit of work that creates lots of short-lived Values like
+    the parsing of a single message.
+
+    Values stored within the scope must not outlive it nor be released from
+    another thread. Only new stores use the arena; copying a Value stored
+    outside the scope never moves it into the arena. Scopes can be nested in
+    which case the innermost one is used. Large and over-aligned objects still
+    go to the heap and types loaded within the scope don't use the arena.
+ */
+struct ValueArena
+{
+    enum {
+        ChunkSize = 64 * 1024,
+        Alignment = 16,
+        MaxBlock = 4 * 1024,
+    };
+
+    ValueArena();
+    ~ValueArena();
+
+    ValueArena(const ValueArena&) = delete;
+    ValueArena& operator=(const ValueArena&) = delete;
+
+    // Innermost arena active on the current thread or null.
+    static ValueArena* current();
+
+    /** Deactivates the current thread's arena for its lifetime. Wraps code
+        that creates Values meant to outlive any arena like type loaders.
+     */
+    struct Suspend
+    {
+        Suspend();
+        ~Suspend();
+
+        Suspend(const Suspend&) = delete;
+        Suspend& operator=(const Suspend&) = delete;
+
+    private:
+        ValueArena* arena;
+    };
+
+    // Returns null when the block should go on the heap instead.
+    static void* alloc(size_t size, size_t align);
+    static void free(void* ptr);
+
+    // Bytes reserved from the system, bytes handed out and the number of
+    // blocks that haven't been freed yet; the last is only tracked if
+    // CheckValueArena is set.
+    size_t memory() const { return memory_; }
+    size_t used() const { return used_; }
+    size_t live() const { return live_; }
+
+private:
+    void* bump(size_t size);
+
+    ValueArena* prev;
+
+    // Chunks are linked through their first word to avoid allocating.
+    void* chunks;
+    uint8_t* pos;
+    uint8_t* end;
+
+    size_t memory_;
+    size_t used_;
+    size_t live_;
+};
+
+} // reflect
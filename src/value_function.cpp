@@ -13,9 +13,17 @@ namespace reflect {
 /* VALUE FUNCTION                                                             */
 /******************************************************************************/
 
+// The size of the block is stashed in front of the function so that it can be
+// handed back to the arena.
+enum { ValueFunctionHeader = Arena::Alignment };
+
 void* allocValueFunction(size_t size)
 {
-    return std::malloc(size);
+    size += ValueFunctionHeader;
+
+    uint8_t* block = static_cast<uint8_t*>(Registry::arena().alloc(size));
+    *reinterpret_cast<size_t*>(block) = size;
+    return block + ValueFunctionHeader;
 }
 
 void freeValueFunction(void* fn)
@@ -25,7 +33,8 @@ void freeValueFunction(void* fn)
     typedef ValueFunction<0> Fn;
     static_cast<Fn*>(fn)->free();
 
-    free(fn);
+    uint8_t* block = static_cast<uint8_t*>(fn) - ValueFunctionHeader;
+    Registry::arena().free(block, *reinterpret_cast<size_t*>(block));
 }
 
 void
@@ -27,6 +27,31 @@
 namespace reflect {
 
 
+/******************************************************************************/
+/* IS SLOT RET                                                                */
+/******************************************************************************/
+
+namespace details {
+
+// Only results returned by value can be constructed in a caller's slot.
+template<typename Ret>
+struct IsSlotRet
+{
+    typedef typename CleanType<Ret>::type CleanRet;
+    typedef std::integral_constant<bool,
+            !std::is_reference<Ret>::value &&
+            std::is_constructible<CleanRet, Ret&&>::value> type;
+};
+
+template<>
+struct IsSlotRet<void>
+{
+    typedef std::false_type type;
+};
+
+} // namespace details
+
+
 /******************************************************************************/
 /* VALUE FUNCTION                                                             */
 /******************************************************************************/
@@ -36,7 +61,24 @@ template<typename Vs> struct ValueFunctionBase;
 template<typename... Values>
 struct ValueFunctionBase< TypeVector<Values...> >
 {
-    virtual Value operator() (Values... values) = 0;
+    // Arguments are taken by reference to avoid copying Values (and touching
+    // their refcounts) at every dispatch layer. Implementations never move out
+    // of their arguments.
+    Value operator() (Values&&... values)
+    {
+        return invoke(nullptr, std::move(values)...);
+    }
+
+    /** If slot isn't null and the function returns by value then the result
+        is constructed in slot, which must be uninitialized memory suitably
+        sized and aligned for the function's clean return type, and an empty
+        Value is returned. Otherwise slot is ignored and the result is
+        returned like it would be by operator().
+
+        This is the only virtual that calls the function so that reflecting a
+        function only instantiates a single typed body.
+     */
+    virtual Value invoke(void* slot, Values&&... values) = 0;
 
     /** Turns out that virtual destructors are absurdly expensive to compile.
         Not sure why but it might have to do with the templated nature of the
@@ -68,23 +110,36 @@ struct ValueFunctionImpl< Fn, TypeVector<Values...> > :
 {
     typedef FunctionType<Fn> FnType;
     typedef typename FnType::Return Ret;
+    typedef typename CleanType<Ret>::type CleanRet;
+    typedef typename details::IsSlotRet<Ret>::type IsSlotRet;
 
     ValueFunctionImpl(Fn fn) : fn(std::move(fn)) {}
 
     // Compile-time optimization. See ValueFunctionBase::free()
     virtual void free() { this->~ValueFunctionImpl(); }
 
-    virtual Value operator() (Values... values)
+    virtual Value invoke(void* slot, Values&&... values)
     {
         typedef typename std::is_same<Ret, void>::type IsVoidRet;
 
-        return call(IsVoidRet(), values...);
+        return call(IsVoidRet(), slot, values...);
     }
 
+    // Address of the function or member function pointer which can be called
+    // without going through Values. Null for functors.
+    const void* native() const
+    {
+        typedef typename FnType::type type;
+        return native(type());
+    }
 
 private:
 
-    Value call(std::true_type, Values&... values)
+    const void* native(GlobalFunction) const { return &fn; }
+    const void* native(MemberFunction) const { return &fn; }
+    const void* native(FunctorFunction) const { return nullptr; }
+
+    Value call(std::true_type, void*, Values&... values)
     {
         typedef typename FnType::type type;
         typedef typename FnType::Arguments Args;
@@ -93,14 +148,31 @@ private:
         return Value();
     }
 
-    Value call(std::false_type, Values&... values)
+    Value call(std::false_type, void* slot, Values&... values)
+    {
+        typedef typename FnType::type type;
+        typedef typename FnType::Arguments Args;
+
+        if (slot && IsSlotRet::value) {
+            construct(IsSlotRet(), slot, values...);
+            return Value();
+        }
+
+        return Value::temporary(call(type(), Args(), values...));
+    }
+
+    // Constructing straight from the call lets the compiler elide the
+    // temporary.
+    void construct(std::true_type, void* slot, Values&... values)
     {
         typedef typename FnType::type type;
         typedef typename FnType::Arguments Args;
 
-        return Value(call(type(), Args(), values...));
+        new (slot) CleanRet(call(type(), Args(), values...));
     }
 
+    void construct(std::false_type, void*, Values&...) {}
+
 
     template<typename... Args>
     Ret call(GlobalFunction, TypeVector<Args...>, Values&... values)
@@ -138,12 +210,34 @@ private:
 /* MAKE VALUE FUNCTION                                                        */
 /******************************************************************************/
 
+namespace details {
+
+// Functors that don't capture anything are stored as plain function pointers
+// which can then be called natively. This also lets all the lambdas of a given
+// signature share a single ValueFunctionImpl.
+template<typename Fn, typename Kind = typename FunctionType<Fn>::type>
+struct StoredFunction
+{
+    typedef Fn type;
+};
+
+template<typename Fn>
+struct StoredFunction<Fn, FunctorFunction>
+{
+    typedef typename FunctionType<Fn>::Fn* Pointer;
+    typedef typename std::conditional<
+        std::is_convertible<Fn, Pointer>::value, Pointer, Fn>::type type;
+};
+
+} // namespace details
+
 template<typename Fn>
 struct MakeValueFunction
 {
-    typedef FunctionType<Fn> FnType;
+    typedef typename details::StoredFunction<Fn>::type StoredFn;
+    typedef FunctionType<StoredFn> FnType;
     typedef typename RepeatType<Value, FnType::ArgCount>::type Values;
-    typedef ValueFunctionImpl<Fn, Values> type;
+    typedef ValueFunctionImpl<StoredFn, Values> type;
 };
 
 
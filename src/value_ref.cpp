@@ -0,0 +1,60 @@
+/* value_ref.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   ValueRef implementation.
+*/
+
+#include "reflect.h"
+
+namespace reflect {
+
+/******************************************************************************/
+/* VALUE REF                                                                  */
+/******************************************************************************/
+
+const std::string&
+ValueRef::
+typeId() const
+{
+    return type()->id();
+}
+
+ValueRef
+ValueRef::
+field(const std::string& field) const
+{
+    const auto& f = type()->field(field);
+    bool isConst = f.argument().isConst() || this->isConst();
+
+    return ValueRef(
+            Argument(f.type(), RefType::LValue, isConst),
+            static_cast<uint8_t*>(value_) + f.offset());
+}
+
+Status
+ValueRef::
+tryField(const std::string& field, ValueRef& out) const
+{
+    const Field* f = type()->tryField(field);
+    if (!f) return Status(StatusCode::NoField, type());
+
+    bool isConst = f->argument().isConst() || this->isConst();
+
+    out = ValueRef(
+            Argument(f->type(), RefType::LValue, isConst),
+            static_cast<uint8_t*>(value_) + f->offset());
+    return Status();
+}
+
+Value
+ValueRef::
+toValue() const
+{
+    Value result;
+    result.arg = arg;
+    result.value_ = value_;
+    return result;
+}
+
+} // reflect
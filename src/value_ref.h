@@ -0,0 +1,64 @@
+/* value_ref.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Borrowed view of a value.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* VALUE REF                                                                  */
+/******************************************************************************/
+
+/** Type-tagged pointer to an object owned by someone else. Unlike Value it
+    never owns anything so it's trivially copyable and walking an object graph
+    through it never touches a refcount. The referenced object must outlive the
+    ValueRef.
+ */
+struct ValueRef
+{
+    ValueRef() : value_(nullptr) {}
+    ValueRef(const Argument& arg, void* value) : arg(arg), value_(value) {}
+
+    // Borrows the object held by the Value.
+    ValueRef(const Value& value) :
+        arg(value.argument()), value_(value.value())
+    {}
+
+    template<typename T>
+    static ValueRef of(T& value);
+
+    void* value() const { return value_; }
+    const Type* type() const { return arg.type(); }
+    const std::string& typeId() const;
+    RefType refType() const { return arg.refType(); }
+    bool isConst() const { return arg.isConst(); }
+    bool isVoid() const { return arg.isVoid(); }
+
+    const Argument& argument() const { return arg; }
+
+    // Get a reference to the value without any type checks.
+    template<typename T> T& as() const;
+    template<typename T> const T& get() const;
+
+    ValueRef field(const std::string& field) const;
+    Status tryField(const std::string& field, ValueRef& out) const;
+
+    template<typename Ret, typename... Args>
+    Ret call(const std::string& fn, Args&&... args) const;
+
+    // Non-owning Value referring to the same object.
+    Value toValue() const;
+
+private:
+    Argument arg;
+    void* value_;
+};
+
+reflectStaticAssert(std::is_trivially_copyable<ValueRef>::value);
+
+} // reflect
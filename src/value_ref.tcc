@@ -0,0 +1,56 @@
+/* value_ref.tcc                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Template implementation for ValueRef.
+*/
+
+#include "reflect.h"
+#pragma once
+
+namespace reflect {
+
+/******************************************************************************/
+/* VALUE REF                                                                  */
+/******************************************************************************/
+
+template<typename T>
+ValueRef
+ValueRef::
+of(T& value)
+{
+    // cast-away any const; the argument remembers it.
+    return ValueRef(Argument::make<T&>(), (void*) &value);
+}
+
+template<typename T>
+T&
+ValueRef::
+as() const
+{
+    if (!type()->isChildOf<T>()) {
+        reflectError("<%s> is not a base of <%s>",
+                type()->id(), reflect::type<T>()->id());
+    }
+
+    return *static_cast<T*>(value_);
+}
+
+template<typename T>
+const T&
+ValueRef::
+get() const
+{
+    return as<T>();
+}
+
+template<typename Ret, typename... Args>
+Ret
+ValueRef::
+call(const std::string& fn, Args&&... args) const
+{
+    const auto& f = type()->function(fn);
+    return f.call<Ret>(*this, std::forward<Args>(args)...);
+}
+
+} // reflect
@@ -0,0 +1,170 @@
+/* alloc_test.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Checks that resolving and dispatching calls doesn't touch the heap.
+*/
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "tests.h"
+#include "reflect.h"
+#include "test_types.h"
+#include "types/primitives.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <new>
+
+using namespace reflect;
+
+
+/******************************************************************************/
+/* ALLOCATIONS                                                                */
+/******************************************************************************/
+
+std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size)
+{
+    allocations++;
+    if (void* ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+// GCC can't tell that our operator new is backed by malloc.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+// The first run warms up the lazily built member tables and call caches.
+template<typename Fn>
+size_t countAllocations(const Fn& fn)
+{
+    fn();
+
+    size_t start = allocations;
+    fn();
+    return allocations - start;
+}
+
+
+/******************************************************************************/
+/* TESTS                                                                      */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(test_params)
+{
+    Function fn("fn", [] (int&, const test::Object&) {});
+
+    int i = 0;
+    test::Object obj;
+
+    Match a, b, c;
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                a = fn.testParams<void>(i, obj);
+                b = fn.testParams<void>(i, i);
+                c = fn.test<void(int&, test::Object&)>();
+            }), 0u);
+
+    BOOST_CHECK_NE(a, Match::None);
+    BOOST_CHECK_EQUAL(b, Match::None);
+    BOOST_CHECK_NE(c, Match::None);
+}
+
+BOOST_AUTO_TEST_CASE(call)
+{
+    const Overloads& fns = type<test::Object>()->function("ref");
+
+    int i = 10;
+    test::Object obj;
+
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                fns.call<void>(obj, i);
+                fns[1].call<void>(obj, i);
+            }), 0u);
+
+    BOOST_CHECK_EQUAL(obj.value, 10);
+}
+
+BOOST_AUTO_TEST_CASE(call_return)
+{
+    Function fn("fn", [] (int i) { return i * 2; });
+
+    int result = 0;
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                result = fn.call<int>(10);
+            }), 0u);
+
+    BOOST_CHECK_EQUAL(result, 20);
+
+    // The result can be copied so it has to be moved to shared storage.
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                Value value = fn.call<Value>(10);
+                Value moved(std::move(value));
+                result = moved.get<int>();
+            }), 1u);
+
+    BOOST_CHECK_EQUAL(result, 20);
+}
+
+BOOST_AUTO_TEST_CASE(value_ref)
+{
+    test::Parent obj(1, 2);
+
+    int result = 0;
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                ValueRef ref = ValueRef::of(obj).field("value");
+                result = ref.call<int>("ref") + cast<int>(ref.field("value"));
+            }), 0u);
+
+    BOOST_CHECK_EQUAL(result, 2);
+}
+
+BOOST_AUTO_TEST_CASE(call_into)
+{
+    const Overloads& fn = type<test::Object>()->function("operator+");
+
+    test::Object obj(1);
+    test::Object result;
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                fn.callInto(result, obj, 2);
+            }), 0u);
+
+    BOOST_CHECK_EQUAL(result.value, 3);
+}
+
+BOOST_AUTO_TEST_CASE(construct_at)
+{
+    const Type* tObject = type<test::Object>();
+
+    std::aligned_storage<sizeof(test::Object), alignof(test::Object)>::type storage;
+    void* obj = &storage;
+
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                tObject->constructAt(obj, 10);
+                tObject->destroyAt(obj);
+            }), 0u);
+
+    CHECK_ERROR(tObject->constructAt(obj, tObject));
+    CHECK_ERROR(type<test::NotConstructible>()->constructAt(obj));
+}
+
+BOOST_AUTO_TEST_CASE(value_arena)
+{
+    int sum = 0;
+    BOOST_CHECK_EQUAL(countAllocations([&] {
+                ValueArena arena;
+
+                for (int i = 0; i < 100; ++i) {
+                    Value obj = Value(test::Object(i));
+                    Value copy = obj;
+                    Value number = Value(i).copy();
+                    Value shared = number;
+                    sum += copy.get<test::Object>().value + shared.get<int>();
+                }
+            }), 0u);
+
+    BOOST_CHECK_EQUAL(sum, 2 * 2 * 4950);
+}
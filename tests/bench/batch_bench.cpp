@@ -0,0 +1,86 @@
+/* batch_bench.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Compares calling a reflected getter over many objects through a loop of
+   Value::call against a single Type::callBatch over Values and over the
+   objects themselves.
+*/
+
+#include "reflect.h"
+#include "bench.h"
+#include "dsl/all.h"
+
+using namespace reflect;
+
+
+/******************************************************************************/
+/* FOO                                                                        */
+/******************************************************************************/
+
+namespace bench {
+
+struct Foo
+{
+    int value;
+
+    __attribute__((noinline))
+    int get() const { return value; }
+};
+
+} // namespace bench
+
+reflectType(bench::Foo)
+{
+    reflectPlumbing();
+    reflectField(value);
+    reflectFn(get);
+}
+
+
+/******************************************************************************/
+/* MAIN                                                                       */
+/******************************************************************************/
+
+int main(int, char**)
+{
+    enum { Objects = 10 * 1000 };
+
+    std::vector<bench::Foo> objects(Objects);
+    for (size_t i = 0; i < objects.size(); ++i) objects[i].value = i;
+
+    std::vector<Value> values;
+    for (auto& obj : objects) values.emplace_back(obj);
+
+    std::vector<int> out(Objects);
+    const Type* tFoo = type<bench::Foo>();
+
+    auto loop = [&] (size_t iterations) {
+        for (size_t it = 0; it < iterations; ++it) {
+            for (size_t i = 0; i < values.size(); ++i)
+                out[i] = values[i].call<int>("get");
+            bench::sink(out.back());
+        }
+    };
+
+    auto batch = [&] (size_t iterations) {
+        for (size_t it = 0; it < iterations; ++it) {
+            tFoo->callBatch<int>("get", span(out), span(values));
+            bench::sink(out.back());
+        }
+    };
+
+    const std::vector<bench::Foo>& cObjects = objects;
+    auto native = [&] (size_t iterations) {
+        for (size_t it = 0; it < iterations; ++it) {
+            tFoo->callBatch<int>("get", span(out), span(cObjects));
+            bench::sink(out.back());
+        }
+    };
+
+    // Each iteration goes over every object so scale back to calls per second.
+    bench::report("Value::call", 1, Objects * bench::run(1, 10, loop));
+    bench::report("Type::callBatch", 1, Objects * bench::run(1, 10, batch));
+    bench::report("Type::callBatch (native)", 1,
+            Objects * bench::run(1, 10, native));
+}
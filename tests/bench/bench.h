@@ -0,0 +1,104 @@
+/* bench.h                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Runtime benchmark utilities.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+namespace bench {
+
+/******************************************************************************/
+/* TIMER                                                                      */
+/******************************************************************************/
+
+struct Timer
+{
+    typedef std::chrono::steady_clock Clock;
+
+    Timer() : start(Clock::now()) {}
+
+    double elapsed() const
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+private:
+    Clock::time_point start;
+};
+
+
+/******************************************************************************/
+/* SINK                                                                       */
+/******************************************************************************/
+
+// Keeps the optimizer from discarding the result of a benchmarked expression.
+template<typename T>
+void sink(const T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+
+/******************************************************************************/
+/* RUN                                                                        */
+/******************************************************************************/
+
+/** Runs fn(iterations) on the given number of threads once they're all ready
+    to go and returns the number of operations per second per thread.
+ */
+template<typename Fn>
+double run(size_t threads, size_t iterations, const Fn& fn)
+{
+    std::atomic<size_t> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<double> elapsed(threads, 0);
+
+    auto runThread = [&] (size_t id) {
+        ready++;
+        while (!go.load());
+
+        Timer timer;
+        fn(iterations);
+        elapsed[id] = timer.elapsed();
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t id = 0; id < threads; ++id)
+        workers.emplace_back(runThread, id);
+
+    while (ready.load() != threads);
+    go = true;
+
+    for (auto& worker : workers) worker.join();
+
+    double total = 0;
+    for (double t : elapsed) total += t;
+    return iterations / (total / threads);
+}
+
+inline void report(const std::string& name, size_t threads, double opsPerThread)
+{
+    std::printf("%-32s %3zu threads: %12.0f ops/s/thread %14.0f ops/s\n",
+            name.c_str(), threads, opsPerThread, opsPerThread * threads);
+}
+
+inline std::vector<size_t> threadCounts()
+{
+    size_t max = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    std::vector<size_t> result;
+    for (size_t n = 1; n < max; n *= 2) result.push_back(n);
+    result.push_back(max);
+    return result;
+}
+
+} // namespace bench
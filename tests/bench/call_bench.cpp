@@ -0,0 +1,104 @@
+/* call_bench.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Measures the overhead of calling a reflected function through its name,
+   through bound invokers and through a std::function relative to a direct
+   call along with the cost of probing for a missing overload and of the
+   number fast lane for arithmetic on Values.
+*/
+
+#include "reflect.h"
+#include "bench.h"
+#include "dsl/all.h"
+
+using namespace reflect;
+
+
+/******************************************************************************/
+/* FOO                                                                        */
+/******************************************************************************/
+
+namespace bench {
+
+struct Foo
+{
+    int value;
+
+    __attribute__((noinline))
+    int bar(int a, int b) const { return value + a * b; }
+};
+
+} // namespace bench
+
+reflectType(bench::Foo)
+{
+    reflectPlumbing();
+    reflectField(value);
+    reflectFn(bar);
+}
+
+
+/******************************************************************************/
+/* MAIN                                                                       */
+/******************************************************************************/
+
+int main(int, char**)
+{
+    enum { Iterations = 10 * 1000 * 1000 };
+
+    bench::Foo foo { 1 };
+    const Overloads& bar = type<bench::Foo>()->function("bar");
+
+    auto direct = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(foo.bar(i, 2));
+    };
+
+    std::function<int(const bench::Foo&, int, int)> stdFn = &bench::Foo::bar;
+    auto stdFunction = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(stdFn(foo, i, 2));
+    };
+
+    auto native = bar.bind<int(const bench::Foo&, int, int)>();
+    auto nativeInvoker = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(native(foo, i, 2));
+    };
+
+    // Forces the arguments through Values by binding a compatible signature.
+    auto boxed = bar.bind<int(bench::Foo&, int, int)>();
+    auto boxedInvoker = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(boxed(foo, i, 2));
+    };
+
+    auto byName = [&] (size_t iterations) {
+        Value value(foo);
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(value.call<int>("bar", int(i), 2));
+    };
+
+    // Probes for an overload that doesn't exist.
+    auto tryCallMiss = [&] (size_t iterations) {
+        Value value(foo);
+        int result = 0;
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(value.tryCall(result, "bar", foo).code());
+    };
+
+    auto add = [&] (size_t iterations) {
+        Value lhs(foo.value);
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink((lhs + int64_t(i)).get<int64_t>());
+    };
+
+    bench::report("direct", 1, bench::run(1, Iterations, direct));
+    bench::report("std::function", 1, bench::run(1, Iterations, stdFunction));
+    bench::report("Invoker (native)", 1, bench::run(1, Iterations, nativeInvoker));
+    bench::report("Invoker (boxed)", 1, bench::run(1, Iterations / 10, boxedInvoker));
+    bench::report("Value::call(name)", 1, bench::run(1, Iterations / 10, byName));
+    bench::report("Value::tryCall(miss)", 1, bench::run(1, Iterations / 10, tryCallMiss));
+    bench::report("Value::operator+", 1, bench::run(1, Iterations / 10, add));
+}
@@ -0,0 +1,77 @@
+/* field_bench.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Compares reading the same few fields over many objects through
+   Value::field and through precompiled FieldHandles.
+*/
+
+#include "reflect.h"
+#include "bench.h"
+#include "dsl/all.h"
+
+using namespace reflect;
+
+
+/******************************************************************************/
+/* POINT                                                                      */
+/******************************************************************************/
+
+namespace bench {
+
+struct Point
+{
+    int x, y, z;
+};
+
+} // namespace bench
+
+reflectType(bench::Point)
+{
+    reflectPlumbing();
+    reflectField(x);
+    reflectField(y);
+    reflectField(z);
+}
+
+
+/******************************************************************************/
+/* MAIN                                                                       */
+/******************************************************************************/
+
+int main(int, char**)
+{
+    enum { Iterations = 1000 * 1000, Objects = 1024 };
+
+    std::vector<bench::Point> points(Objects);
+    for (size_t i = 0; i < points.size(); ++i)
+        points[i] = { int(i), int(i * 2), int(i * 3) };
+
+    const Type* tPoint = type<bench::Point>();
+
+    auto byName = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i) {
+            Value value(points[i % Objects]);
+            bench::sink(
+                    value.field<int>("x") +
+                    value.field<int>("y") +
+                    value.field<int>("z"));
+        }
+    };
+
+    FieldHandle<int> x(tPoint, "x"), y(tPoint, "y"), z(tPoint, "z");
+
+    auto byHandle = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i) {
+            const bench::Point* point = &points[i % Objects];
+            bench::sink(x.get(point) + y.get(point) + z.get(point));
+        }
+    };
+
+    for (size_t threads : bench::threadCounts()) {
+        bench::report("Value::field(name)", threads,
+                bench::run(threads, Iterations, byName));
+        bench::report("FieldHandle::get", threads,
+                bench::run(threads, Iterations, byHandle));
+    }
+}
@@ -0,0 +1,58 @@
+/* registry_bench.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Measures how registry lookups scale with the number of reader threads. The
+   locked variant emulates a registry guarded by a single global mutex.
+*/
+
+#include "reflect.h"
+#include "bench.h"
+#include "types/std/string.h"
+
+#include <mutex>
+
+using namespace reflect;
+
+
+/******************************************************************************/
+/* MAIN                                                                       */
+/******************************************************************************/
+
+int main(int, char**)
+{
+    enum { Iterations = 1000 * 1000 };
+
+    const std::vector<std::string> ids = {
+        "int", "unsigned int", "double", "std::string", "int*", "uint64_t"
+    };
+    for (const auto& id : ids) type(id);
+
+    std::mutex lock;
+
+    auto lookup = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(type(ids[i % ids.size()]));
+    };
+
+    auto lockedLookup = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i) {
+            std::lock_guard<std::mutex> guard(lock);
+            bench::sink(type(ids[i % ids.size()]));
+        }
+    };
+
+    auto cachedLookup = [&] (size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+            bench::sink(type<std::string>());
+    };
+
+    for (size_t threads : bench::threadCounts()) {
+        bench::report("type(id)", threads,
+                bench::run(threads, Iterations, lookup));
+        bench::report("type(id) global lock", threads,
+                bench::run(threads, Iterations, lockedLookup));
+        bench::report("type<T>()", threads,
+                bench::run(threads, Iterations, cachedLookup));
+    }
+}
@@ -185,3 +185,72 @@ BOOST_AUTO_TEST_CASE(baz)
     BOOST_CHECK_EQUAL(vBazParent.field<int>("shadowed"), bazParent.shadowed);
     BOOST_CHECK_NE(vBaz.field<int>("shadowed"), bazParent.shadowed);
 }
+
+
+/******************************************************************************/
+/* HANDLE                                                                     */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(handle)
+{
+    const Type* tFoo = type("Foo");
+    const Type* tBar = type("Bar");
+    const Type* tBaz = type("Baz");
+
+    BOOST_CHECK(!FieldHandle<int>());
+
+    FieldHandle<int> hField(tFoo, "field");
+    BOOST_CHECK(hField);
+    BOOST_CHECK_EQUAL(hField.owner(), tFoo);
+    BOOST_CHECK_EQUAL(hField.offset(), tFoo->field("field").offset());
+    BOOST_CHECK(!hField.isConst());
+
+    Foo foo;
+    BOOST_CHECK_EQUAL(&hField.get(&foo), &foo.field);
+
+    hField.set(&foo, 321);
+    BOOST_CHECK_EQUAL(foo.field, 321);
+    BOOST_CHECK_EQUAL(hField.get(static_cast<const Foo*>(&foo)), 321);
+
+    Value vFoo(foo);
+    hField.set(vFoo, 654);
+    BOOST_CHECK_EQUAL(hField.get(vFoo), 654);
+    BOOST_CHECK_EQUAL(vFoo.field<int>("field"), 654);
+
+    // Values are checked for their type and constness.
+    const Foo& cFoo = foo;
+    Value vConstFoo(cFoo);
+    FieldHandle<const int> hConstField(tFoo, "field");
+    BOOST_CHECK_EQUAL(hConstField.get(vConstFoo), 654);
+    CHECK_ERROR(hField.get(vConstFoo));
+    CHECK_ERROR(hField.set(vConstFoo, 1));
+    CHECK_ERROR(hField.get(Value(Bar())));
+    CHECK_ERROR(hField.set(Value(Bar()), 1));
+
+    FieldHandle<int> hPrivate(tFoo, "privateField");
+    hPrivate.set(&foo, 987);
+    BOOST_CHECK_EQUAL(foo.getPrivateField(), 987);
+
+    FieldHandle<const int> hConst(tFoo, "constField");
+    BOOST_CHECK(hConst.isConst());
+    BOOST_CHECK_EQUAL(&hConst.get(&foo), &foo.constField);
+    CHECK_ERROR(FieldHandle<int>(tFoo, "constField"));
+
+    CHECK_ERROR(FieldHandle<int>(tFoo, "bob"));
+    CHECK_ERROR(FieldHandle<unsigned>(tFoo, "field"));
+    CHECK_ERROR(FieldHandle<Foo>(tBar, "constObject"));
+
+    Bar bar;
+    FieldHandle<Foo> hObject(tBar, "object");
+    hObject.get(&bar).field = 147;
+    BOOST_CHECK_EQUAL(bar.object.field, 147);
+    BOOST_CHECK_EQUAL(&hField.get(&hObject.get(&bar)), &bar.object.field);
+
+    Baz baz;
+    FieldHandle<int> hShadowed(tBaz, "shadowed");
+    FieldHandle<Foo> hInherited(tBaz, "object");
+    hShadowed.set(&baz, 1);
+    BOOST_CHECK_EQUAL(baz.shadowed, 1);
+    BOOST_CHECK_EQUAL(static_cast<Bar&>(baz).shadowed, 0);
+    BOOST_CHECK_EQUAL(&hInherited.get(&baz), &baz.object);
+}
@@ -10,6 +10,7 @@
 
 #include "tests.h"
 #include "reflect.h"
+#include "dsl/all.h"
 #include "test_types.h"
 #include "types/primitives.h"
 
@@ -652,3 +653,335 @@ BOOST_AUTO_TEST_CASE(converters_call)
     BOOST_CHECK_EQUAL(rrefFn.call<int>(convConstLRef), doRRef(convConstLRef));
     BOOST_CHECK_EQUAL(rrefFn.call<int>(Conv(10)), doRRef(Conv(10)));
 }
+
+BOOST_AUTO_TEST_CASE(converters_lookup)
+{
+    typedef test::Convertible Conv;
+
+    const Type* tConv = type<Conv>();
+
+    BOOST_CHECK( tConv->hasConverter<int>());
+    BOOST_CHECK( tConv->hasConverter<test::Parent>());
+    BOOST_CHECK(!tConv->hasConverter<test::Object>());
+    BOOST_CHECK(!tConv->hasConverter<Conv>());
+
+    BOOST_CHECK_EQUAL(tConv->converter<int>().call<int>(Conv(12)), 12);
+    CHECK_ERROR(tConv->converter<test::Object>());
+
+    BOOST_CHECK(!type<int>()->hasConverter<Conv>());
+}
+
+
+/******************************************************************************/
+/* BIND                                                                       */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(bind)
+{
+    Function add("add", [] (int a, int b) { return a + b; });
+
+    BOOST_CHECK(!Invoker<int(int, int)>());
+
+    auto native = add.bind<int(int, int)>();
+    BOOST_CHECK(native);
+    BOOST_CHECK(native.isNative());
+    BOOST_CHECK_EQUAL(native(1, 2), 3);
+
+    auto boxed = add.bind<int(const int&, int)>();
+    BOOST_CHECK(!boxed.isNative());
+    BOOST_CHECK_EQUAL(boxed(3, 4), 7);
+
+    auto discard = add.bind<void(int, int)>();
+    BOOST_CHECK(!discard.isNative());
+    discard(5, 6);
+
+    CHECK_ERROR(add.bind<int(test::Object, int)>());
+    CHECK_ERROR(add.bind<int(int)>());
+
+    // Functors that capture can't be called natively.
+    int offset = 10;
+    Function addOffset("addOffset", [=] (int a) { return a + offset; });
+    auto captured = addOffset.bind<int(int)>();
+    BOOST_CHECK(!captured.isNative());
+    BOOST_CHECK_EQUAL(captured(1), 11);
+
+    const Type* tObject = type<test::Object>();
+    test::Object obj(10);
+
+    auto plus = tObject->function("operator+")
+        .bind<test::Object(const test::Object&, int)>();
+    BOOST_CHECK(plus.isNative());
+    BOOST_CHECK_EQUAL(plus(obj, 5).value, 15);
+
+    // Picks the overload that matches natively.
+    auto ref = tObject->function("ref").bind<int&(test::Object&)>();
+    BOOST_CHECK(ref.isNative());
+    BOOST_CHECK_EQUAL(&ref(obj), &obj.value);
+
+    auto setRef = tObject->function("ref").bind<void(test::Object&, int&)>();
+    BOOST_CHECK(setRef.isNative());
+
+    int value = 20;
+    setRef(obj, value);
+    BOOST_CHECK_EQUAL(obj.value, 20);
+
+    CHECK_ERROR(tObject->function("ref").bind<int(int)>());
+}
+
+
+/******************************************************************************/
+/* OVERLOADS                                                                  */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(overloads)
+{
+    using test::Parent;
+    using test::Child;
+
+    Overloads fns;
+    fns.add(Function("fn", [] { return 0; }));
+    fns.add(Function("fn", [] (int i) { return i; }));
+    fns.add(Function("fn", [] (const Parent&) { return 1; }));
+    fns.add(Function("fn", [] (const Child&) { return 2; }));
+    fns.add(Function("fn", [] (int i, int j) { return i + j; }));
+    fns.add(Function("fn", [] (const Parent&, int j) { return j; }));
+
+    CHECK_ERROR(fns.add(Function("fn", [] (int i) { return i; })));
+    BOOST_CHECK_EQUAL(fns.size(), 6u);
+
+    BOOST_CHECK(fns.test<int()>());
+    BOOST_CHECK(fns.test<int(int, int)>());
+    BOOST_CHECK(!fns.test<int(int, int, int)>());
+    BOOST_CHECK(!fns.test<int(test::Object)>());
+
+    BOOST_CHECK_EQUAL(fns.call<int>(), 0);
+    BOOST_CHECK_EQUAL(fns.call<int>(10), 10);
+    BOOST_CHECK_EQUAL(fns.call<int>(1, 2), 3);
+
+    Parent parent(1, 2);
+    Child child(1, 2);
+    const Child& cchild = child;
+
+    // Identical signatures are found without scanning the overloads.
+    BOOST_CHECK_EQUAL(fns.call<int>(static_cast<const Parent&>(parent)), 1);
+    BOOST_CHECK_EQUAL(fns.call<int>(cchild), 2);
+
+    // Falls back to the linear scan for everything else.
+    BOOST_CHECK_EQUAL(fns.call<int>(parent), 1);
+    BOOST_CHECK_EQUAL(fns.call<int>(cchild, 3), 3);
+    CHECK_ERROR(fns.call<int>(1, 2, 3));
+    CHECK_ERROR(fns.call<int>(test::Object(1)));
+}
+
+
+/******************************************************************************/
+/* BATCH                                                                      */
+/******************************************************************************/
+
+struct BatchObject
+{
+    int value;
+    int get() const { return value; }
+    int plus(int i) const { return value + i; }
+    BatchObject twice() const { return BatchObject{ value * 2 }; }
+};
+
+reflectType(BatchObject)
+{
+    reflectPlumbing();
+    reflectFn(get);
+    reflectFn(plus);
+    reflectFn(twice);
+}
+
+BOOST_AUTO_TEST_CASE(batch)
+{
+    using test::Object;
+
+    const Type* tObject = type<Object>();
+
+    std::vector<Object> objects;
+    for (int i = 0; i < 10; ++i) objects.emplace_back(i);
+
+    std::vector<Value> values;
+    for (auto& obj : objects) values.emplace_back(obj);
+
+    std::vector<int> ints(values.size());
+    tObject->callBatch<int>("ref", span(ints), span(values));
+    for (size_t i = 0; i < ints.size(); ++i)
+        BOOST_CHECK_EQUAL(ints[i], objects[i].value);
+
+    // Broadcast scalar.
+    std::vector<Object> sums(values.size());
+    tObject->callBatch<Object>("operator+", span(sums), span(values), 5);
+    for (size_t i = 0; i < sums.size(); ++i)
+        BOOST_CHECK_EQUAL(sums[i].value, objects[i].value + 5);
+
+    // Per-element arguments.
+    tObject->callBatch<Object>("operator+", span(sums), span(values), span(ints));
+    for (size_t i = 0; i < sums.size(); ++i)
+        BOOST_CHECK_EQUAL(sums[i].value, objects[i].value * 2);
+
+    // Only the first few elements.
+    std::vector<int> head(3, -1);
+    tObject->function("ref").callBatch<int>(span(head), span(values));
+    BOOST_CHECK_EQUAL(head[2], 2);
+
+    // Typed arguments are only resolved once and exact native signatures
+    // skip the Values entirely.
+    std::vector<BatchObject> batch;
+    for (int i = 0; i < 10; ++i) batch.push_back(BatchObject{ i * 3 });
+
+    const std::vector<BatchObject>& cBatch = batch;
+    const Overloads& get = type<BatchObject>()->function("get");
+    BOOST_CHECK(get[0].isNative<int(const BatchObject&)>());
+    get.callBatch<int>(span(ints), span(cBatch));
+    for (size_t i = 0; i < ints.size(); ++i)
+        BOOST_CHECK_EQUAL(ints[i], batch[i].value);
+
+    // Mutable elements are passed to const getters and trivially copyable
+    // scalars by value. The native path never stores the results in Values.
+    std::vector<BatchObject> twices(batch.size());
+    {
+        ValueArena arena;
+        type<BatchObject>()->function("twice")
+            .callBatch<BatchObject>(span(twices), span(batch));
+        BOOST_CHECK_EQUAL(arena.used(), 0u);
+    }
+    for (size_t i = 0; i < twices.size(); ++i)
+        BOOST_CHECK_EQUAL(twices[i].value, batch[i].value * 2);
+
+    const Overloads& plus = type<BatchObject>()->function("plus");
+    BOOST_CHECK(plus[0].isNative<int(const BatchObject&, int)>());
+    plus.callBatch<int>(span(ints), span(batch), 1);
+    for (size_t i = 0; i < ints.size(); ++i)
+        BOOST_CHECK_EQUAL(ints[i], batch[i].value + 1);
+
+    tObject->callBatch<Object>("operator+", span(sums), span(objects), 3);
+    for (size_t i = 0; i < sums.size(); ++i)
+        BOOST_CHECK_EQUAL(sums[i].value, objects[i].value + 3);
+
+    std::vector<int> big(values.size() + 1);
+    CHECK_ERROR(tObject->callBatch<int>("ref", span(big), span(values)));
+}
+
+
+/******************************************************************************/
+/* ARENA                                                                      */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(arena)
+{
+    Arena& arena = Registry::arena();
+
+    Function a("foo", [] (int i, const test::Object&) { return i; });
+    Function b("foo", [] (int i, const test::Object&) { return i + 1; });
+
+    // Names and argument lists are interned.
+    BOOST_CHECK_EQUAL(&a.name(), &b.name());
+    BOOST_CHECK_EQUAL(&a.argument(0), &b.argument(0));
+    BOOST_CHECK_EQUAL(b.call<int>(1, test::Object(0)), 2);
+
+    BOOST_CHECK_GT(arena.memory(), 0u);
+    BOOST_CHECK_LE(arena.used(), arena.memory());
+
+    // Thunks are recycled once freed.
+    size_t used = arena.used();
+    {
+        Function c("bar", [] (int i, const test::Object&) { return i; });
+        BOOST_CHECK_GT(arena.used(), used);
+    }
+    BOOST_CHECK_EQUAL(arena.used(), used);
+
+    void* block = arena.alloc(Arena::MaxBlock + 1);
+    BOOST_CHECK_GT(arena.used(), used);
+    arena.free(block, Arena::MaxBlock + 1);
+    BOOST_CHECK_EQUAL(arena.used(), used);
+}
+
+
+/******************************************************************************/
+/* CALL INTO                                                                  */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(call_into)
+{
+    using test::Object;
+
+    Object obj(10);
+    Value value(obj);
+
+    Object sum;
+    value.callInto(sum, "operator+", 5);
+    BOOST_CHECK_EQUAL(sum.value, 15);
+    BOOST_CHECK_EQUAL(obj.value, 10);
+
+    const Function& fn = type<Object>()->function("operator+")[0];
+    fn.callInto((void*) &sum, obj, 1);
+    BOOST_CHECK_EQUAL(sum.value, 11);
+
+    // References are copied into the slot.
+    int i = 0;
+    value.callInto(i, "ref");
+    BOOST_CHECK_EQUAL(i, 10);
+
+    // Falls back to a regular call when the types differ.
+    Value boxed;
+    Function twice("twice", [] (int i) { return i * 2; });
+    twice.callInto(boxed, 4);
+    BOOST_CHECK_EQUAL(boxed.get<int>(), 8);
+
+    CHECK_ERROR(twice.callInto((void*) &i, obj));
+    CHECK_ERROR(Function("void", [] {}).callInto((void*) &i));
+
+    test::NotCopiable nc;
+    Function notCopiable("nc", [&] () -> const test::NotCopiable& { return nc; });
+    CHECK_ERROR(notCopiable.callInto((void*) &nc));
+}
+
+
+/******************************************************************************/
+/* TRY CALL                                                                   */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(try_call)
+{
+    using test::Object;
+
+    Object obj(10);
+    Value value(obj);
+
+    Object sum;
+    BOOST_CHECK(value.tryCall(sum, "operator+", 5));
+    BOOST_CHECK_EQUAL(sum.value, 15);
+
+    int i = 0;
+    Status status = value.tryCall(i, "ref");
+    BOOST_CHECK(status.ok());
+    BOOST_CHECK_EQUAL(status.code(), StatusCode::Ok);
+    BOOST_CHECK_EQUAL(status.message(), "");
+    BOOST_CHECK_EQUAL(i, 10);
+
+    // Only a code and a pointer to what failed.
+    BOOST_CHECK_LE(sizeof(Status), 2 * sizeof(void*));
+
+    status = value.tryCall(sum, "operator+", obj);
+    BOOST_CHECK(!status);
+    BOOST_CHECK_EQUAL(status.code(), StatusCode::NoOverload);
+    BOOST_CHECK_EQUAL(status.message(),
+            "no overload available for function <operator+>");
+
+    std::string name = "blah";
+    status = value.tryCall(i, name);
+    BOOST_CHECK_EQUAL(status.code(), StatusCode::NoFunction);
+    BOOST_CHECK_NE(
+            status.message().find(type<Object>()->id()), std::string::npos);
+
+    // Failed probes aren't cached.
+    const Overloads& fn = type<Object>()->function("operator+");
+    size_t misses = fn.cacheMisses();
+    BOOST_CHECK(!fn.tryCall(sum, obj, obj));
+    BOOST_CHECK(fn.tryCall(sum, obj, 1));
+    BOOST_CHECK_EQUAL(sum.value, 11);
+    BOOST_CHECK_GT(fn.cacheMisses(), misses);
+}
@@ -0,0 +1,349 @@
+/* registry_test.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Tests for the type registry.
+*/
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "tests.h"
+#include "reflect.h"
+#include "dsl/all.h"
+#include "test_types.h"
+
+#include <boost/test/unit_test.hpp>
+#include <set>
+#include <chrono>
+#include <thread>
+
+using namespace reflect;
+
+
+/******************************************************************************/
+/* RACE                                                                       */
+/******************************************************************************/
+
+std::atomic<size_t> raceLoads(0);
+
+#define reflectRace(n)                                  \
+    struct Race ## n { Race ## n* next; int value; };   \
+                                                        \
+    reflectType(Race ## n)                              \
+    {                                                   \
+        raceLoads++;                                    \
+        reflectPlumbing();                              \
+        reflectField(next);                             \
+        reflectField(value);                            \
+    }
+
+#define reflectRace4(n)                         \
+    reflectRace(n ## 0)                         \
+    reflectRace(n ## 1)                         \
+    reflectRace(n ## 2)                         \
+    reflectRace(n ## 3)
+
+reflectRace4(0)
+reflectRace4(1)
+reflectRace4(2)
+reflectRace4(3)
+reflectRace4(4)
+reflectRace4(5)
+reflectRace4(6)
+reflectRace4(7)
+
+
+/******************************************************************************/
+/* WARM                                                                       */
+/******************************************************************************/
+
+namespace warm {
+
+struct B;
+struct A { B* b; int value; };
+struct B { A* a; int value; };
+struct C { A a; B b; };
+
+} // namespace warm
+
+reflectTypeDecl(warm::A)
+reflectTypeDecl(warm::B)
+reflectTypeDecl(warm::C)
+
+reflectTypeImpl(warm::A)
+{
+    reflectPlumbing();
+    reflectField(b);
+    reflectField(value);
+}
+
+reflectTypeImpl(warm::B)
+{
+    reflectPlumbing();
+    reflectField(a);
+    reflectField(value);
+}
+
+reflectTypeImpl(warm::C)
+{
+    reflectPlumbing();
+    reflectField(a);
+    reflectField(b);
+}
+
+/******************************************************************************/
+/* CYCLE                                                                      */
+/******************************************************************************/
+
+namespace cycle {
+
+struct Y;
+struct X { Y* y; };
+struct Y { X* x; };
+
+} // namespace cycle
+
+reflectTypeDecl(cycle::X)
+reflectTypeDecl(cycle::Y)
+
+// The sleeps make sure that both loaders are running by the time they need
+// each other's type.
+reflectTypeImpl(cycle::X)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    reflectPlumbing();
+    reflectField(y);
+}
+
+reflectTypeImpl(cycle::Y)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    reflectPlumbing();
+    reflectField(x);
+}
+
+/******************************************************************************/
+/* CACHE                                                                      */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(cache)
+{
+    typedef const test::Object* PtrT;
+
+    const Type* tInt = type<int>();
+    const Type* tObject = type<test::Object>();
+    const Type* tPtr = type<PtrT>();
+
+    BOOST_CHECK_EQUAL(tInt, type("int"));
+    BOOST_CHECK_EQUAL(tObject, type("test::Object"));
+    BOOST_CHECK_EQUAL(tPtr, type(typeId<PtrT>()));
+
+    BOOST_CHECK_EQUAL(type<int>(), tInt);
+    BOOST_CHECK_EQUAL(type<const int&>(), tInt);
+    BOOST_CHECK_EQUAL(type<PtrT>(), tPtr);
+
+    Registry::clearCache();
+
+    BOOST_CHECK_EQUAL(type<int>(), tInt);
+    BOOST_CHECK_EQUAL(type<test::Object>(), tObject);
+    BOOST_CHECK_EQUAL(type<PtrT&&>(), tPtr);
+}
+
+
+/******************************************************************************/
+/* INDEX                                                                      */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(index_)
+{
+    const Type* tInt = type<int>();
+    const Type* tObject = type<test::Object>();
+
+    BOOST_CHECK_NE(tInt->index(), 0u);
+    BOOST_CHECK_NE(tObject->index(), 0u);
+    BOOST_CHECK_NE(tInt->index(), tObject->index());
+
+    BOOST_CHECK_LT(tInt->index(), Registry::indexes());
+    BOOST_CHECK_LT(tObject->index(), Registry::indexes());
+
+    BOOST_CHECK_EQUAL(type(tInt->index()), tInt);
+    BOOST_CHECK_EQUAL(type(tObject->index()), tObject);
+    BOOST_CHECK_EQUAL(type(type("int64_t")->index()), type<int64_t>());
+
+    CHECK_ERROR(type(TypeIndex(0)));
+    CHECK_ERROR(type(Registry::indexes()));
+}
+
+
+/******************************************************************************/
+/* CONCURRENT LOAD                                                            */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(concurrent_load)
+{
+    enum { Threads = 16, Types = 32 };
+
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 4; ++j)
+            ids.push_back("Race" + std::to_string(i) + std::to_string(j));
+    }
+
+    std::atomic<bool> go(false);
+    std::vector< std::vector<const Type*> > results(Threads);
+
+    auto run = [&] (size_t thread) {
+        auto& result = results[thread];
+        result.resize(Types * 2);
+
+        while (!go.load());
+
+        for (size_t i = 0; i < Types; ++i) {
+            size_t index = (i + thread) % Types;
+            result[index] = type(ids[index]);
+            result[Types + index] = result[index]->field("next").type();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < Threads; ++i) threads.emplace_back(run, i);
+    go = true;
+    for (auto& thread : threads) thread.join();
+
+    BOOST_CHECK_EQUAL(raceLoads.load(), size_t(Types));
+
+    for (size_t i = 0; i < Types; ++i) {
+        const Type* expected = type(ids[i]);
+        BOOST_CHECK_EQUAL(expected->id(), ids[i]);
+        BOOST_CHECK(expected->hasField("value"));
+
+        const Type* pointer = type(ids[i] + "*");
+        BOOST_CHECK(pointer->isPointer());
+        BOOST_CHECK_EQUAL(pointer->pointee(), expected);
+
+        for (size_t thread = 0; thread < Threads; ++thread) {
+            BOOST_CHECK_EQUAL(results[thread][i], expected);
+            BOOST_CHECK_EQUAL(results[thread][Types + i], pointer);
+        }
+    }
+}
+
+
+/******************************************************************************/
+/* CONCURRENT CYCLE                                                           */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(concurrent_cycle)
+{
+    const Type* tX = nullptr;
+    const Type* tY = nullptr;
+
+    std::thread loadX([&] { tX = type("cycle::X"); });
+    std::thread loadY([&] { tY = type("cycle::Y"); });
+    loadX.join();
+    loadY.join();
+
+    BOOST_CHECK_EQUAL(tX->field("y").type()->pointee(), tY);
+    BOOST_CHECK_EQUAL(tY->field("x").type()->pointee(), tX);
+}
+
+/******************************************************************************/
+/* WARMUP                                                                     */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(warmup)
+{
+    // Boost.Test assertions aren't thread-safe so the reader only records
+    // whether it saw a partial type.
+    std::atomic<bool> done(false);
+    std::atomic<bool> partial(false);
+    std::thread reader([&] {
+                while (!done) {
+                    if (!type("warm::B")->hasField("a")) partial = true;
+                }
+            });
+
+    WarmupReport report = Registry::warmup(scope("warm"), 4);
+
+    done = true;
+    reader.join();
+    BOOST_CHECK(!partial);
+
+    BOOST_CHECK_EQUAL(report.threads, 4u);
+    BOOST_CHECK_GE(report.elapsed, 0.0);
+    BOOST_CHECK_GT(report.memory(), 0u);
+
+    std::set<std::string> ids;
+    for (const auto& entry : report.types) {
+        ids.insert(entry.id);
+        BOOST_CHECK_LE(entry.thread, 4u);
+        BOOST_CHECK_GE(entry.elapsed, 0.0);
+        BOOST_CHECK_GT(entry.memory, 0u);
+    }
+
+    // The reader may load A and B before the warmup starts but it never
+    // touches C.
+    BOOST_CHECK(ids.count("warm::C"));
+
+    const Type* tA = type("warm::A");
+    const Type* tB = type("warm::B");
+    BOOST_CHECK_EQUAL(tA->field("b").type()->pointee(), tB);
+    BOOST_CHECK_EQUAL(tB->field("a").type()->pointee(), tA);
+    BOOST_CHECK_EQUAL(type("warm::C")->field("a").type(), tA);
+
+    // Nothing left to load.
+    BOOST_CHECK(Registry::warmup(scope("warm"), 4).types.empty());
+}
+
+
+/******************************************************************************/
+/* FAILED LOAD                                                                */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(failedLoad)
+{
+    Registry::add("failed::A", [] (Type*) {
+                throw std::runtime_error("loader failed");
+            });
+
+    BOOST_CHECK_THROW(type("failed::A"), std::runtime_error);
+    CHECK_ERROR(type("failed::A"));
+
+#if REFLECT_USE_EXCEPTIONS
+
+    // Threads waiting on a failed load must be woken up instead of blocking
+    // forever. Boost.Test assertions aren't thread-safe so the threads only
+    // record what they saw.
+    std::atomic<bool> started(false);
+    std::atomic<bool> fail(false);
+
+    Registry::add("failed::B", [&] (Type*) {
+                started = true;
+                while (!fail);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                throw std::runtime_error("loader failed");
+            });
+
+    std::atomic<bool> loaderThrew(false);
+    std::thread loader([&] {
+                try { type("failed::B"); }
+                catch (const std::runtime_error&) { loaderThrew = true; }
+            });
+
+    std::atomic<bool> waiterThrew(false);
+    std::thread waiter([&] {
+                while (!started);
+                fail = true;
+                try { type("failed::B"); }
+                catch (const reflect::Error&) { waiterThrew = true; }
+            });
+
+    loader.join();
+    waiter.join();
+
+    BOOST_CHECK(loaderThrew);
+    BOOST_CHECK(waiterThrew);
+
+#endif
+}
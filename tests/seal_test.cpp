@@ -0,0 +1,168 @@
+/* seal_test.cpp                                 -*- C++ -*-
+   agent (agent@local), 18 Oct 2026
+   FreeBSD-style copyright and disclaimer apply
+
+   Tests for sealed registries.
+*/
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "tests.h"
+#include "reflect.h"
+#include "dsl/all.h"
+#include "test_types.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace reflect;
+
+
+/******************************************************************************/
+/* SEALED                                                                     */
+/******************************************************************************/
+
+namespace sealed {
+
+int twice(int i) { return i * 2; }
+
+struct Sealed
+{
+    int value;
+    int get() const { return value; }
+};
+
+} // namespace sealed
+
+reflectScope(sealed)
+{
+    reflectScopeTrait(frozen);
+    reflectGlobalFn(sealed::twice);
+}
+
+reflectType(sealed::Sealed)
+{
+    reflectPlumbing();
+    reflectTypeValue(answer, 42);
+
+    reflectField(value);
+    reflectFieldTrait(value, json);
+
+    reflectFn(get);
+    reflectFnTrait(get, getter);
+}
+
+
+/******************************************************************************/
+/* PERFECT HASH                                                               */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(perfect_hash)
+{
+    BOOST_CHECK(!PerfectHash<int>().find(""));
+
+    for (size_t n : { 1, 2, 3, 10, 100, 1000, 10000 }) {
+        std::vector< std::pair<std::string, int> > items;
+        for (size_t i = 0; i < n; ++i)
+            items.emplace_back("key" + std::to_string(i), i);
+
+        PerfectHash<int> table(items);
+        BOOST_CHECK_EQUAL(table.size(), n);
+
+        for (const auto& item : items) {
+            const int* value = table.find(item.first);
+            BOOST_REQUIRE(value);
+            BOOST_CHECK_EQUAL(*value, item.second);
+        }
+
+        BOOST_CHECK(!table.find(""));
+        BOOST_CHECK(!table.find("key"));
+        BOOST_CHECK(!table.find("key" + std::to_string(n)));
+
+        size_t count = 0;
+        table.forEach([&] (const std::string&, int) { count++; });
+        BOOST_CHECK_EQUAL(count, n);
+    }
+}
+
+
+/******************************************************************************/
+/* SEAL                                                                       */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(seal)
+{
+    const Type* tInt = type<int>();
+    const Type* tChild = type<test::Child>();
+
+    BOOST_CHECK(!Registry::isSealed());
+    Registry::seal();
+    BOOST_CHECK(Registry::isSealed());
+    Registry::seal();
+
+    BOOST_CHECK_EQUAL(type("int"), tInt);
+    BOOST_CHECK_EQUAL(type<int>(), tInt);
+    BOOST_CHECK_EQUAL(type("test::Child"), tChild);
+    BOOST_CHECK_EQUAL(type("int64_t"), type<int64_t>());
+    BOOST_CHECK_EQUAL(type(tChild->index()), tChild);
+
+    // Loaders that were pending before the seal are now loaded.
+    const Type* tSealed = type("sealed::Sealed");
+    BOOST_CHECK_EQUAL(type<sealed::Sealed>(), tSealed);
+
+    // Template instantiations can't be loaded once sealed.
+    CHECK_ERROR(type<sealed::Sealed*>());
+
+    BOOST_CHECK(tSealed->is("answer"));
+    BOOST_CHECK(!tSealed->is("question"));
+    BOOST_CHECK_EQUAL(tSealed->getValue<int>("answer"), 42);
+
+    BOOST_CHECK(tSealed->hasField("value"));
+    BOOST_CHECK(!tSealed->hasField("blah"));
+    BOOST_CHECK(tSealed->field("value").is("json"));
+    BOOST_CHECK_EQUAL(tSealed->field("value").type(), tInt);
+
+    BOOST_CHECK(tSealed->hasFunction("get"));
+    BOOST_CHECK(!tSealed->hasFunction("blah"));
+    BOOST_CHECK(tSealed->function("get").is("getter"));
+
+    sealed::Sealed obj { 10 };
+    BOOST_CHECK_EQUAL(Value(obj).call<int>("get"), 10);
+
+    BOOST_CHECK(tChild->hasField("value"));
+    BOOST_CHECK(tChild->hasField("childValue"));
+    BOOST_CHECK(tChild->hasFunction("normalVirtual"));
+    BOOST_CHECK_EQUAL(tChild->field("shadowed").type(), type<bool>());
+
+    Scope* sSealed = scope("sealed");
+    BOOST_CHECK(sSealed->is("frozen"));
+    BOOST_CHECK(sSealed->hasType("Sealed"));
+    BOOST_CHECK_EQUAL(sSealed->type("Sealed"), tSealed);
+    BOOST_CHECK(scope()->hasType("sealed::Sealed"));
+    BOOST_CHECK(scope()->hasScope("sealed"));
+    BOOST_CHECK_EQUAL(scope()->call<int>("sealed::twice", 4), 8);
+
+    CHECK_ERROR(type("blah"));
+    CHECK_ERROR(scope("blah"));
+}
+
+BOOST_AUTO_TEST_CASE(seal_mutations)
+{
+    Registry::seal();
+
+    Type* tSealed = const_cast<Type*>(type<sealed::Sealed>());
+
+    CHECK_ERROR(Registry::alias<sealed::Sealed>("blah"));
+    CHECK_ERROR(Registry::add("blah", [] (Type*) {}));
+    CHECK_ERROR(tSealed->addTrait("blah"));
+    CHECK_ERROR(tSealed->field("value").addTrait("blah"));
+    CHECK_ERROR(tSealed->function("get").addTrait("blah"));
+    CHECK_ERROR(tSealed->addField<int>("blah", 0));
+    CHECK_ERROR(tSealed->addFunction("blah", &sealed::twice));
+    CHECK_ERROR(tSealed->parent(type<int>()));
+    CHECK_ERROR(scope()->addFunction("blah", &sealed::twice));
+    CHECK_ERROR(scope()->scope("blah"));
+
+    // Template loaders for types that were loaded before the seal are fine.
+    Registry::add<sealed::Sealed>();
+}
@@ -38,6 +38,14 @@ int signalNet()
     return WIFSIGNALED(status) ? 1 : 0;
 }
 
+// Errors that always abort regardless of REFLECT_USE_EXCEPTIONS.
+#define CHECK_ABORT(p)                          \
+    do {                                        \
+        int ret = test::signalNet();            \
+        if (ret == -1) { (p); exit(0); }        \
+        BOOST_CHECK_EQUAL(ret, 1);              \
+    } while (false)
+
 #if REFLECT_USE_EXCEPTIONS
 # define CHECK_ERROR(p) BOOST_CHECK_THROW((p), reflect::Error)
 #else
@@ -11,6 +11,7 @@
 
 #include "reflect.h"
 #include "test_types.h"
+#include "types/std/string.h"
 
 #include <boost/test/unit_test.hpp>
 
@@ -209,3 +210,193 @@ BOOST_AUTO_TEST_CASE(converter)
     BOOST_CHECK( tConvertible->hasConverter<test::Parent>());
     BOOST_CHECK(!tConvertible->hasConverter<test::Convertible>());
 }
+
+BOOST_AUTO_TEST_CASE(flattened)
+{
+    const Type* tChild = type<test::Child>();
+
+    std::vector<std::string> fields { "childValue", "shadowed", "value" };
+    BOOST_CHECK(tChild->fields() == fields);
+    BOOST_CHECK_EQUAL(&tChild->fields(), &tChild->fields());
+
+    const auto& fns = tChild->functions();
+    BOOST_CHECK(std::is_sorted(fns.begin(), fns.end()));
+    BOOST_CHECK(std::adjacent_find(fns.begin(), fns.end()) == fns.end());
+    BOOST_CHECK(std::count(fns.begin(), fns.end(), "normalVirtual"));
+    BOOST_CHECK(std::count(fns.begin(), fns.end(), "pureVirtual"));
+
+    // Modifying a parent must be reflected in the tables of its children.
+    std::unique_ptr<Type> base(new Type("flat::Base"));
+    std::unique_ptr<Type> derived(new Type("flat::Derived"));
+
+    base->addField<int>("a", 0);
+    derived->parent(base.get());
+    derived->addField<int>("b", sizeof(int));
+
+    BOOST_CHECK(derived->hasField("a"));
+    BOOST_CHECK(!derived->hasField("c"));
+    BOOST_CHECK_EQUAL(derived->fields().size(), 2u);
+
+    // Types that aren't loaded only rebuild their tables when modified.
+    BOOST_CHECK_EQUAL(&derived->fields(), &derived->fields());
+    BOOST_CHECK_EQUAL(&derived->functions(), &derived->functions());
+
+    base->addField<int>("c", 2 * sizeof(int));
+    BOOST_CHECK(derived->hasField("c"));
+
+    const Type* cDerived = derived.get();
+    BOOST_CHECK_EQUAL(cDerived->field("c").offset(), 2 * sizeof(int));
+    BOOST_CHECK_EQUAL(derived->fields().size(), 3u);
+
+    base->addFunction("fn", [] { return 10; });
+    BOOST_CHECK(derived->hasFunction("fn"));
+    BOOST_CHECK_EQUAL(derived->functions().size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(display)
+{
+    const Type* tParentPtr = type<test::Parent*>();
+    const Type* tChildPtr = type<test::Child*>();
+    BOOST_CHECK( tChildPtr->isChildOf(tParentPtr));
+    BOOST_CHECK(!tParentPtr->isChildOf(tChildPtr));
+    BOOST_CHECK(!tChildPtr->isChildOf<test::Child>());
+    BOOST_CHECK(!type<test::Child>()->isChildOf(tChildPtr));
+    BOOST_CHECK_EQUAL(tChildPtr->pointer(), "*");
+
+    // Changing the parent of a type must be reflected in the displays of all
+    // its descendants.
+    std::unique_ptr<Type> root(new Type("display::Root"));
+    std::unique_ptr<Type> base(new Type("display::Base"));
+    std::unique_ptr<Type> derived(new Type("display::Derived"));
+
+    derived->parent(base.get());
+    BOOST_CHECK( derived->isChildOf(base.get()));
+    BOOST_CHECK(!derived->isChildOf(root.get()));
+    BOOST_CHECK(!root->isChildOf(derived.get()));
+
+    base->parent(root.get());
+    BOOST_CHECK( derived->isChildOf(root.get()));
+    BOOST_CHECK( base->isChildOf(root.get()));
+    BOOST_CHECK(!root->isChildOf(base.get()));
+}
+
+BOOST_AUTO_TEST_CASE(traitKeys)
+{
+    BOOST_CHECK_EQUAL(traitKey("pointer"), TraitKey(traits::Pointer));
+    BOOST_CHECK_EQUAL(traitKey("valueType"), TraitKey(traits::ValueType));
+    BOOST_CHECK_EQUAL(traitName(traits::Json), "json");
+    BOOST_CHECK_EQUAL(traitKey("traitKeys::custom"), traitKey("traitKeys::custom"));
+
+    BOOST_CHECK( type<int*>()->is(traits::Pointer));
+    BOOST_CHECK( type<int>()->is(traits::Integer));
+    BOOST_CHECK(!type<int>()->is(traits::Float));
+    BOOST_CHECK_EQUAL(*type<int>()->findValue<size_t>(traits::Sizeof), sizeof(int));
+    BOOST_CHECK_EQUAL(*type<int>()->findValue<size_t>(traits::Alignof), alignof(int));
+    BOOST_CHECK( type<int>()->is(traits::Trivial));
+
+    std::unique_ptr<Type> type(new Type("traitKeys::Type"));
+    type->addTrait("traitKeys::custom", 10);
+
+    TraitKey custom = traitKey("traitKeys::custom");
+    BOOST_CHECK(type->is(custom));
+    BOOST_CHECK(!type->is(traits::Json));
+    BOOST_CHECK(!type->findValue<int>(traits::Json));
+    BOOST_CHECK_EQUAL(type->getValue<int>(custom), 10);
+    BOOST_CHECK_EQUAL(*type->findValue<int>(custom), 10);
+    BOOST_CHECK_EQUAL(type->findValue<int>(custom), type->findValue<int>(custom));
+
+    // Keys past the bitset go through the slots.
+    for (size_t i = 0; i < 100; ++i)
+        type->addTrait("traitKeys::many" + std::to_string(i), size_t(i));
+
+    for (size_t i = 0; i < 100; ++i) {
+        TraitKey key = traitKey("traitKeys::many" + std::to_string(i));
+        BOOST_CHECK(type->is(key));
+        BOOST_CHECK_EQUAL(type->getValue<size_t>(key), i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(callCache)
+{
+    const Type* tObject = type<test::Object>();
+    const Overloads& fns = tObject->function("test::Object");
+
+    size_t hits = fns.cacheHits();
+    size_t misses = fns.cacheMisses();
+
+    for (size_t i = 0; i < 10; ++i)
+        BOOST_CHECK_EQUAL(tObject->construct(int(i)).get<test::Object>().value, i);
+
+    BOOST_CHECK_EQUAL(fns.cacheMisses(), misses + 1);
+    BOOST_CHECK_EQUAL(fns.cacheHits(), hits + 9);
+
+    // A different shape picks a different overload.
+    test::Object obj(10);
+    Value copy = tObject->construct(obj);
+    BOOST_CHECK_EQUAL(copy.get<test::Object>().value, 10);
+    BOOST_CHECK_EQUAL(fns.cacheMisses(), misses + 2);
+
+    copy = tObject->construct(obj);
+    BOOST_CHECK_EQUAL(fns.cacheHits(), hits + 10);
+
+    BOOST_CHECK_EQUAL(tObject->construct(int(42)).get<test::Object>().value, 42);
+    BOOST_CHECK_EQUAL(fns.cacheHits(), hits + 11);
+
+    // Cycling through more shapes than the cache holds keeps evicting entries
+    // but never stops the caching.
+    int i = 1;
+    const int& cI = i;
+    const test::Object& cObj = obj;
+    for (size_t round = 0; round < 100; ++round) {
+        tObject->construct(int(1));
+        tObject->construct(i);
+        tObject->construct(cI);
+        tObject->construct(obj);
+        tObject->construct(cObj);
+        tObject->construct(test::Object(1));
+    }
+
+    hits = fns.cacheHits();
+    tObject->construct(int(1));
+    tObject->construct(int(1));
+    BOOST_CHECK_EQUAL(fns.cacheHits(), hits + 1);
+}
+
+BOOST_AUTO_TEST_CASE(constructAt)
+{
+    const Type* tObject = type<test::Object>();
+    BOOST_CHECK(tObject->hasDestructor());
+    BOOST_CHECK(!tObject->hasFunction("~"));
+
+    std::aligned_storage<sizeof(test::Object), alignof(test::Object)>::type objStorage;
+    void* obj = &objStorage;
+
+    tObject->constructAt(obj, int(10));
+    BOOST_CHECK_EQUAL(static_cast<test::Object*>(obj)->value, 10);
+    tObject->destroyAt(obj);
+
+    test::Object other(20);
+    tObject->constructAt(obj, other);
+    BOOST_CHECK_EQUAL(static_cast<test::Object*>(obj)->value, 20);
+    BOOST_CHECK_EQUAL(other.value, 20);
+    tObject->destroyAt(obj);
+
+    const Type* tString = type<std::string>();
+    BOOST_CHECK_EQUAL(tString->size(), sizeof(std::string));
+    BOOST_CHECK_EQUAL(tString->alignment(), alignof(std::string));
+
+    std::aligned_storage<sizeof(std::string), alignof(std::string)>::type strStorage;
+    void* str = &strStorage;
+
+    // Long enough to not fit in the small string buffer so that a missing
+    // destructor call shows up as a leak.
+    std::string value(100, 'a');
+    tString->constructAt(str, value);
+    BOOST_CHECK_EQUAL(*static_cast<std::string*>(str), value);
+    tString->destroyAt(str);
+
+    int i = 0;
+    type<int>()->constructAt(&i, int(42));
+    BOOST_CHECK_EQUAL(i, 42);
+    type<int>()->destroyAt(&i);
+}
@@ -34,3 +34,16 @@ BOOST_AUTO_TEST_CASE(test_compact)
     Basics::construct(value);
     checkFile("value_printer_compact.json", value, true);
 }
+
+BOOST_AUTO_TEST_CASE(test_ref)
+{
+    Basics value;
+    Basics::construct(value);
+
+    std::stringstream ss;
+    Writer writer(ss, Writer::Options(Writer::Default | Writer::Pretty));
+    print(writer, ValueRef::of(value));
+    BOOST_CHECK(!writer.error());
+
+    checkFile("value_printer_full.json", ss.str());
+}
@@ -131,6 +131,62 @@ BOOST_AUTO_TEST_CASE(destruct)
 }
 
 
+/******************************************************************************/
+/* DESTROY AT                                                                 */
+/******************************************************************************/
+
+struct DestroyBase
+{
+    static size_t bases;
+    virtual ~DestroyBase() { bases++; }
+};
+size_t DestroyBase::bases = 0;
+
+struct DestroyDerived : public DestroyBase
+{
+    static size_t deriveds;
+    ~DestroyDerived() { deriveds++; }
+};
+size_t DestroyDerived::deriveds = 0;
+
+struct DestroyPartial : public DestroyBase {};
+
+reflectType(DestroyBase) { reflectPlumbing(); }
+
+reflectType(DestroyDerived)
+{
+    reflectParent(DestroyBase);
+    reflectPlumbing();
+}
+
+reflectType(DestroyPartial) { reflectParent(DestroyBase); }
+
+BOOST_AUTO_TEST_CASE(destroyAt)
+{
+    {
+        std::aligned_storage<sizeof(DestroyDerived)>::type mem;
+        type<DestroyDerived>()->constructAt(&mem);
+        type<DestroyDerived>()->destroyAt(&mem);
+
+        BOOST_CHECK_EQUAL(DestroyBase::bases, 1u);
+        BOOST_CHECK_EQUAL(DestroyDerived::deriveds, 1u);
+    }
+
+    // The parent's destructor isn't used in place of the child's.
+    {
+        std::aligned_storage<sizeof(DestroyPartial)>::type mem;
+        new (&mem) DestroyPartial;
+
+        BOOST_CHECK(type<DestroyBase>()->hasDestructor());
+        BOOST_CHECK(!type<DestroyPartial>()->hasDestructor());
+        BOOST_CHECK(!type<DestroyPartial>()->hasFunction("~"));
+        CHECK_ERROR(type<DestroyPartial>()->destroyAt(&mem));
+
+        reinterpret_cast<DestroyPartial*>(&mem)->~DestroyPartial();
+    }
+}
+
+
 /******************************************************************************/
 /* LVALUE                                                                     */
 /******************************************************************************/
@@ -254,3 +310,390 @@ BOOST_AUTO_TEST_CASE(copyMove)
         BOOST_CHECK_EQUAL(obj.value, 0);
     }
 }
+
+
+/******************************************************************************/
+/* INLINE                                                                     */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(inline_)
+{
+    // Copies of a Value refer to the same object, scalars included.
+    Value value(int(10));
+    Value copy = value;
+    BOOST_CHECK_EQUAL(copy.value(), value.value());
+
+    copy.assign(20);
+    BOOST_CHECK_EQUAL(value.get<int>(), 20);
+
+    Value assigned;
+    assigned = value;
+    assigned.assign(30);
+    BOOST_CHECK_EQUAL(copy.get<int>(), 30);
+
+    Value moved(std::move(copy));
+    BOOST_CHECK_EQUAL(moved.value(), value.value());
+
+    // The results of a call are moved out of the Value before they're handed
+    // out which makes them just as shareable.
+    Function fn("fn", [] { return 10; });
+    Value result = fn.call<Value>();
+    Value resultCopy = result;
+    resultCopy.assign(20);
+    BOOST_CHECK_EQUAL(result.get<int>(), 20);
+
+    // Same for arguments passed as rvalues to a Value parameter.
+    Function param("param", [] (Value arg) {
+                Value argCopy = arg;
+                argCopy.assign(20);
+                return arg.get<int>();
+            });
+    BOOST_CHECK_EQUAL(param.call<int>(10), 20);
+
+    std::vector<Value> values;
+    for (int i = 0; i < 100; ++i) values.emplace_back(int(i));
+    for (int i = 0; i < 100; ++i) BOOST_CHECK_EQUAL(values[i].get<int>(), i);
+}
+
+BOOST_AUTO_TEST_CASE(castConst)
+{
+    // References point into the caller's Value rather than into a copy.
+    const Value value(int(10));
+    const int& ref = cast<const int&>(value);
+    BOOST_CHECK_EQUAL(&ref, value.value());
+
+    Function fn("fn", [] { return 10; });
+    const Value result = fn.call<Value>();
+    BOOST_CHECK_EQUAL(&cast<const int&>(result), result.value());
+}
+
+
+/******************************************************************************/
+/* VALUE REF                                                                  */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(valueRef)
+{
+    test::Parent obj(1, 2);
+    ValueRef ref = ValueRef::of(obj);
+
+    BOOST_CHECK_EQUAL(ref.type(), type<test::Parent>());
+    BOOST_CHECK_EQUAL(ref.value(), &obj);
+    BOOST_CHECK_EQUAL(ref.refType(), RefType::LValue);
+    BOOST_CHECK(!ref.isConst());
+
+    // Walking fields yields more refs into the same object.
+    ValueRef value = ref.field("value");
+    BOOST_CHECK_EQUAL(value.value(), &obj.value);
+    BOOST_CHECK_EQUAL(value.field("value").get<int>(), 1);
+    BOOST_CHECK_EQUAL(cast<int>(ref.field("shadowed")), 2);
+
+    Value vObj(obj);
+    ValueRef fromValue = vObj.field<ValueRef>("value");
+    BOOST_CHECK_EQUAL(fromValue.value(), &obj.value);
+    BOOST_CHECK_EQUAL(ValueRef(vObj).value(), vObj.value());
+
+    value.field("value").as<int>() = 10;
+    BOOST_CHECK_EQUAL(obj.value.value, 10);
+
+    // Functions accept refs wherever they'd accept a Value.
+    BOOST_CHECK_EQUAL(value.call<int>("ref"), 10);
+    int i = 20;
+    type<test::Object>()->function("ref").call<void>(value, i);
+    BOOST_CHECK_EQUAL(obj.value.value, 20);
+
+    Value borrowed = value.toValue();
+    BOOST_CHECK(!borrowed.isStored());
+    BOOST_CHECK_EQUAL(borrowed.value(), &obj.value);
+
+    const test::Parent& cObj = obj;
+    BOOST_CHECK(ValueRef::of(cObj).isConst());
+    BOOST_CHECK(ValueRef::of(cObj).field("value").isConst());
+
+    BOOST_CHECK(ValueRef().isVoid());
+}
+
+
+/******************************************************************************/
+/* TRY                                                                        */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(try_)
+{
+    test::Parent obj(1, 2);
+    Value value(obj);
+
+    Value field;
+    BOOST_CHECK(value.tryField("shadowed", field));
+    BOOST_CHECK_EQUAL(field.value(), &obj.shadowed);
+
+    Status status = value.tryField("blah", field);
+    BOOST_CHECK_EQUAL(status.code(), StatusCode::NoField);
+    BOOST_CHECK_NE(
+            status.message().find(type<test::Parent>()->id()),
+            std::string::npos);
+
+    ValueRef ref;
+    BOOST_CHECK(ValueRef(value).tryField("value", ref));
+    BOOST_CHECK_EQUAL(ref.value(), &obj.value);
+    BOOST_CHECK_EQUAL(
+            ValueRef(value).tryField("blah", ref).code(), StatusCode::NoField);
+
+    int i = 0;
+    BOOST_CHECK(tryCast(Value(10), i));
+    BOOST_CHECK_EQUAL(i, 10);
+
+    test::Parent parent;
+    BOOST_CHECK(tryCast(Value(test::Child(3)), parent));
+    BOOST_CHECK_EQUAL(parent.value.value, 3);
+
+    status = tryCast(value, i);
+    BOOST_CHECK_EQUAL(status.code(), StatusCode::NotCopiable);
+    BOOST_CHECK(!status.message().empty());
+
+    Value out;
+    status = tryCast(value, Argument::make<test::Child&>(), out);
+    BOOST_CHECK_EQUAL(status.code(), StatusCode::NotCastable);
+    BOOST_CHECK_NE(
+            status.message().find(type<test::Child>()->id()),
+            std::string::npos);
+    BOOST_CHECK(out.isVoid());
+
+    BOOST_CHECK(tryCast(value, Argument::make<test::Parent&>(), out));
+    BOOST_CHECK_EQUAL(out.value(), &obj);
+}
+
+
+/******************************************************************************/
+/* TRIVIAL                                                                    */
+/******************************************************************************/
+
+struct Pod
+{
+    int a;
+    double b;
+    char c[20];
+};
+
+reflectType(Pod) { reflectPlumbing(); }
+
+struct MoveOnlyPod
+{
+    MoveOnlyPod() : a(0) {}
+    explicit MoveOnlyPod(int a) : a(a) {}
+    MoveOnlyPod(const MoveOnlyPod&) = delete;
+    MoveOnlyPod(MoveOnlyPod&&) = default;
+    MoveOnlyPod& operator=(MoveOnlyPod&&) = default;
+
+    int a;
+};
+
+reflectType(MoveOnlyPod) { reflectPlumbing(); }
+
+struct ConstPod
+{
+    const int a;
+    int b;
+};
+
+reflectType(ConstPod) { reflectPlumbing(); }
+
+BOOST_AUTO_TEST_CASE(trivial)
+{
+    BOOST_CHECK(type<Pod>()->isTriviallyCopyable());
+    BOOST_CHECK_EQUAL(type<Pod>()->size(), sizeof(Pod));
+    BOOST_CHECK_EQUAL(type<Pod>()->alignment(), alignof(Pod));
+    BOOST_CHECK(type<int>()->isTriviallyCopyable());
+    BOOST_CHECK(!type<test::Object>()->isTriviallyCopyable());
+    BOOST_CHECK(!type<test::Parent>()->isTriviallyCopyable());
+
+    Pod pod { 1, 2.0, "abc" };
+    Value value(pod);
+
+    Value copy = value.copy();
+    BOOST_CHECK(copy.isStored());
+    BOOST_CHECK_NE(copy.value(), &pod);
+    BOOST_CHECK_EQUAL(copy.get<Pod>().a, 1);
+    BOOST_CHECK_EQUAL(copy.get<Pod>().b, 2.0);
+    BOOST_CHECK_EQUAL(std::string(copy.get<Pod>().c), "abc");
+
+    Pod other = cast<Pod>(value);
+    BOOST_CHECK_EQUAL(other.a, 1);
+
+    copy.as<Pod>().a = 10;
+    value.assign(copy);
+    BOOST_CHECK_EQUAL(pod.a, 10);
+
+    Value moved = copy.move();
+    BOOST_CHECK(copy.isVoid());
+    BOOST_CHECK_EQUAL(moved.get<Pod>().a, 10);
+
+    // Copies of scalars are shared like any other copy.
+    Value i = Value(10).copy();
+    Value iCopy = i;
+    iCopy.assign(20);
+    BOOST_CHECK_EQUAL(i.get<int>(), 20);
+
+    // Const values can't be assigned to.
+    const Pod& cPod = pod;
+    CHECK_ERROR(Value(cPod).assign(moved));
+
+    // Trivially copyable types that can't be copied or assigned don't get
+    // the memcpy paths.
+    BOOST_CHECK(!type<MoveOnlyPod>()->isTriviallyCopyable());
+    BOOST_CHECK(!type<MoveOnlyPod>()->isCopiable());
+    CHECK_ERROR(Value(MoveOnlyPod(1)).copy());
+
+    Value moveOnly(MoveOnlyPod(2));
+    BOOST_CHECK_EQUAL(moveOnly.move().get<MoveOnlyPod>().a, 2);
+
+    ConstPod constPod{ 1, 2 };
+    BOOST_CHECK(!type<ConstPod>()->isTriviallyCopyable());
+    BOOST_CHECK_EQUAL(Value(constPod).copy().get<ConstPod>().a, 1);
+    CHECK_ERROR(Value(constPod).assign(Value(ConstPod{ 3, 4 })));
+}
+
+
+/******************************************************************************/
+/* NUMBERS                                                                    */
+/******************************************************************************/
+
+BOOST_AUTO_TEST_CASE(numbers)
+{
+    BOOST_CHECK_EQUAL(type<int>()->numberKind(), NumberKind::Int);
+    BOOST_CHECK_EQUAL(type<double>()->numberKind(), NumberKind::Double);
+    BOOST_CHECK_EQUAL(type<test::Object>()->numberKind(), NumberKind::None);
+
+    Value sum = Value(1) + Value(2.5);
+    BOOST_CHECK_EQUAL(sum.type(), type<double>());
+    BOOST_CHECK_EQUAL(sum.get<double>(), 3.5);
+
+    Value product = Value(short(3)) * Value(4u);
+    BOOST_CHECK_EQUAL(product.type(), type<unsigned>());
+    BOOST_CHECK_EQUAL(product.get<unsigned>(), 12u);
+
+    BOOST_CHECK_EQUAL((Value(7) % Value(int64_t(4))).get<int64_t>(), 3);
+    BOOST_CHECK_EQUAL((Value(6) ^ Value(3)).get<int>(), 5);
+    CHECK_ERROR(Value(1) / Value(0));
+    CHECK_ERROR(Value(1.0) % Value(2.0));
+
+    BOOST_CHECK(Value(1) < Value(1.5));
+    BOOST_CHECK(Value(2) == Value(2.0));
+    BOOST_CHECK(Value('a') != Value(98));
+    BOOST_CHECK(Value(3u) >= Value(3));
+
+    int i = 10;
+    Value ref(i);
+    ref += 5;
+    BOOST_CHECK_EQUAL(i, 15);
+    ref *= Value(2.5);
+    BOOST_CHECK_EQUAL(i, 37);
+
+    ref.assign(int64_t(4));
+    BOOST_CHECK_EQUAL(i, 4);
+    ref.assign(Value(2.0));
+    BOOST_CHECK_EQUAL(i, 2);
+
+    const int& cI = i;
+    CHECK_ERROR(Value(cI) += 1);
+
+    BOOST_CHECK(Value(1));
+    BOOST_CHECK(!Value(0.0));
+
+    // By-value casts widen without a registered converter.
+    BOOST_CHECK_EQUAL(cast<int64_t>(Value(int(-3))), -3);
+    BOOST_CHECK_EQUAL(cast<double>(Value(3.5f)), 3.5);
+    CHECK_ERROR(cast<int>(Value(int64_t(3))));
+    CHECK_ERROR(cast<unsigned>(Value(int(3))));
+
+    // isCastable and overload resolution agree with cast.
+    BOOST_CHECK(isCastable<int64_t>(Value(int(-3))));
+    BOOST_CHECK(isCastable<double>(Value(3.5f)));
+    BOOST_CHECK(!isCastable<int>(Value(int64_t(3))));
+    BOOST_CHECK(!isCastable<unsigned>(Value(int(3))));
+    BOOST_CHECK(!isCastable<int64_t&>(Value(int(3))));
+
+    BOOST_CHECK(Argument::make<int>().isConvertibleTo(Argument::make<int64_t>())
+            == Match::Partial);
+
+    Function widen("widen", [] (int64_t value) { return value * 2; });
+    BOOST_CHECK_EQUAL(widen.call<int64_t>(Value(int(-3))), -6);
+    BOOST_CHECK_EQUAL(widen.call<int64_t>(int(4)), 8);
+    CHECK_ERROR(widen.call<int64_t>(3.5));
+
+    Function narrow("narrow", [] (int value) { return value; });
+    CHECK_ERROR(narrow.call<int>(int64_t(3)));
+}
+
+
+/******************************************************************************/
+/* ARENA                                                                      */
+/******************************************************************************/
+
+struct Big
+{
+    char data[ValueArena::MaxBlock * 2];
+};
+
+reflectType(Big) { reflectPlumbing(); }
+
+BOOST_AUTO_TEST_CASE(arena)
+{
+    BOOST_CHECK(!ValueArena::current());
+
+    {
+        ValueArena arena;
+        BOOST_CHECK_EQUAL(ValueArena::current(), &arena);
+
+        Value obj(test::Object(10));
+        BOOST_CHECK_EQUAL(obj.get<test::Object>().value, 10);
+        BOOST_CHECK_GT(arena.used(), sizeof(test::Object));
+        BOOST_CHECK_EQUAL(arena.live(), 1u);
+
+        {
+            ValueArena nested;
+            BOOST_CHECK_EQUAL(ValueArena::current(), &nested);
+
+            Value copy = obj.copy();
+            BOOST_CHECK_EQUAL(nested.live(), 1u);
+            BOOST_CHECK_EQUAL(arena.live(), 1u);
+        }
+
+        BOOST_CHECK_EQUAL(ValueArena::current(), &arena);
+
+        // Too large for the arena.
+        Value big = Value(Big()).copy();
+        BOOST_CHECK(big.isStored());
+        BOOST_CHECK_EQUAL(arena.live(), 1u);
+
+        obj = Value();
+        BOOST_CHECK_EQUAL(arena.live(), 0u);
+    }
+
+    BOOST_CHECK(!ValueArena::current());
+
+    // Copying Values stored outside of the arena doesn't move them in.
+    {
+        Value outside(42);
+        Value object(test::Object(10));
+
+        {
+            ValueArena arena;
+            Value copy = outside;
+            Value objectCopy = object;
+            BOOST_CHECK_EQUAL(copy.get<int>(), 42);
+            BOOST_CHECK_EQUAL(objectCopy.get<test::Object>().value, 10);
+            BOOST_CHECK_EQUAL(arena.live(), 0u);
+        }
+
+        BOOST_CHECK_EQUAL(outside.get<int>(), 42);
+        BOOST_CHECK_EQUAL(object.get<test::Object>().value, 10);
+    }
+
+    auto escape = [] {
+        Value escaped;
+        ValueArena arena;
+        escaped = Value(test::Object(1));
+    };
+    CHECK_ABORT(escape());
+}